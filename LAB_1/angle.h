@@ -0,0 +1,999 @@
+#ifndef ANGLE_H
+#define ANGLE_H
+#ifndef _USE_MATH_DEFINES
+#define _USE_MATH_DEFINES
+#endif
+#include <string>
+#include <vector>
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+#include <limits>
+#include <span>
+#include <cstdint>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <string_view>
+#include <ostream>
+#include <memory>
+#include <cassert>
+
+
+namespace detail {
+    // Точный fmod для константных выражений: вычитание y * 2^k из x при
+    // y * 2^k <= x < y * 2^(k+1) точно по лемме Стербенца, поэтому результат
+    // совпадает с std::fmod бит в бит.
+    template <typename T>
+    constexpr T constexpr_fmod(T x, T y) {
+        if (x != x || y != y || y == 0 || x - x != 0) { return std::numeric_limits<T>::quiet_NaN(); }
+        if (x < 0) { return -constexpr_fmod(-x, y); }
+        if (y < 0) { y = -y; }
+        if (x < y) { return x; }
+        T step = y;
+        while (step <= x / 2) { step *= 2; }
+        while (step >= y) {
+            if (x >= step) { x -= step; }
+            step /= 2;
+        }
+        return x;
+    }
+
+    inline std::to_chars_result write_text(char* first, char* last, std::string_view text) {
+        if (last - first < static_cast<std::ptrdiff_t>(text.size())) { return {last, std::errc::value_too_large}; }
+        return {std::copy(text.begin(), text.end(), first), std::errc()};
+    }
+    // Тот же вид, что у std::to_string: фиксированная точка, шесть знаков.
+    template <typename T>
+    std::to_chars_result write_radians(char* first, char* last, T rad) {
+        return std::to_chars(first, last, rad, std::chars_format::fixed, 6);
+    }
+    // Наибольшее k, при котором 10^k точно представимо в T: 5^k помещается в мантиссу.
+    template <typename T>
+    constexpr int exact_pow10_limit() {
+        int k = 0;
+        for (T power = 5; power <= T(uint64_t(1) << std::min(std::numeric_limits<T>::digits, 63)); power *= 5) { ++k; }
+        return k;
+    }
+    // std::from_chars с быстрым путём для обычной десятичной записи: знак,
+    // цифры и точка. Если целая мантисса и 10^k точны в T, одно деление
+    // округляется верно (быстрый путь Клингера) и даёт тот же результат, что
+    // from_chars; всё прочее - экспонента, inf, длинная мантисса - идёт в from_chars.
+    template <typename T>
+    std::from_chars_result parse_number(const char* first, const char* last, T& value) {
+        constexpr int max_scale = exact_pow10_limit<T>();
+        constexpr uint64_t max_mantissa = uint64_t(1) << std::min(std::numeric_limits<T>::digits, 63);
+        const char* ptr = first + (first != last && *first == '-');
+        uint64_t mantissa = 0;
+        int digits = 0, scale = 0;
+        for (; ptr != last && static_cast<unsigned>(*ptr - '0') < 10 && digits < 19; ++ptr, ++digits) {
+            mantissa = mantissa * 10 + (*ptr - '0');
+        }
+        if (ptr != last && *ptr == '.') {
+            for (++ptr; ptr != last && static_cast<unsigned>(*ptr - '0') < 10 && digits < 19; ++ptr, ++digits, ++scale) {
+                mantissa = mantissa * 10 + (*ptr - '0');
+            }
+        }
+        bool plain = digits > 0 && mantissa <= max_mantissa && scale <= max_scale
+            && (ptr == last || (static_cast<unsigned>(*ptr - '0') >= 10 && *ptr != 'e' && *ptr != 'E' && *ptr != '.'));
+        if (!plain) { return std::from_chars(first, last, value); }
+        static constexpr T powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+        T result = static_cast<T>(mantissa) / powers[scale];
+        value = *first == '-' ? -result : result;
+        return {ptr, std::errc()};
+    }
+    inline const char* skip_spaces(const char* first, const char* last) {
+        while (first != last && (*first == ' ' || *first == '\t')) { ++first; }
+        return first;
+    }
+    // Сдвигает first за token, если текст начинается с него.
+    inline bool consume(const char*& first, const char* last, std::string_view token) {
+        if (static_cast<std::size_t>(last - first) < token.size() || std::string_view(first, token.size()) != token) {
+            return false;
+        }
+        first += token.size();
+        return true;
+    }
+    inline bool consume_bool(const char*& first, const char* last, bool& value) {
+        if (consume(first, last, "true")) { value = true; }
+        else if (consume(first, last, "false")) { value = false; }
+        else { return false; }
+        return true;
+    }
+    // Массив тривиально копируемых значений из байтов одним memcpy.
+    template <typename U>
+    std::size_t copy_from_bytes(std::span<const std::byte> bytes, std::span<U> out) {
+        static_assert(std::is_trivially_copyable_v<U>);
+        if (bytes.size() % sizeof(U) != 0) { throw std::invalid_argument("Byte count is not a multiple of the value size"); }
+        std::size_t count = bytes.size() / sizeof(U);
+        if (out.size() < count) { throw std::invalid_argument("Output is too small"); }
+        std::memcpy(out.data(), bytes.data(), bytes.size());
+        return count;
+    }
+    // Наибольшая длина числа в write_radians: все цифры целой части, знак, точка и дробь.
+    template <typename T>
+    constexpr std::size_t radians_size = std::numeric_limits<T>::max_exponent10 + 10;
+}
+
+
+// Точность тригонометрии:
+//   exact - std::sin, std::cos и std::tan из libm;
+//   fast  - приведение Коди-Уэйта к [-pi/4, pi/4] и многочлены: не более
+//           2 ULP для sin/cos float и double, tan - 4 ULP вдали от полюсов;
+//   table - таблица из 2048 узлов с поправкой первого порядка: абсолютная
+//           ошибка sin/cos не более 1.3e-6 при любом T.
+// fast и table работают при |x| <= 8e5, дальше и для long double - как exact.
+// Для from_vector table - то же, что fast: многочлен для atan2 с ошибкой не
+// более 1e-8 рад для double и 6e-7 рад (чуть больше ULP(2pi)) для float.
+enum class TrigAccuracy { exact, fast, table };
+
+template <typename T>
+struct SinCos {
+    T sin;
+    T cos;
+};
+
+namespace detail {
+    constexpr double trig_limit = 8e5;
+    // Прибавление и вычитание 1.5 * 2^52 округляет double до целого без вызова
+    // библиотеки, и такой цикл векторизуется.
+    constexpr double round_shifter = 6755399441055744.0;
+
+    template <typename T>
+    constexpr bool has_fast_trig = sizeof(T) <= sizeof(double);
+
+    // Сумма a + b и её ошибка округления (TwoSum).
+    template <typename T>
+    inline T two_sum(T a, T b, T& error) {
+        T sum = a + b;
+        T b_part = sum - a;
+        error = (a - (sum - b_part)) + (b - b_part);
+        return sum;
+    }
+    // x = q * pi/2 + r: pi/2 разбито на части по 33 бита, так что k * часть
+    // точно при |k| < 2^20. Для float хватает трёх частей; для double вблизи
+    // кратных pi/2 r мало и ошибки вычитаний копятся отдельно.
+    template <typename T>
+    inline double reduce_quadrant(double x, int& quadrant) {
+        constexpr double pio2_1 = 1.57079632673412561417e+00, pio2_2 = 6.07710050630396597660e-11;
+        constexpr double pio2_3 = 2.02226624871116645580e-21, pio2_3t = 8.47842766036889956997e-32;
+        double k = (x * 0.63661977236758134308 + round_shifter) - round_shifter;
+        quadrant = static_cast<int>(k);
+        if constexpr (sizeof(T) <= sizeof(float)) { return ((x - k * pio2_1) - k * pio2_2) - k * pio2_3; }
+        else {
+            double error1, error2;
+            double r = two_sum(two_sum(x - k * pio2_1, -k * pio2_2, error1), -k * pio2_3, error2);
+            return r + ((error1 + error2) - k * pio2_3t);
+        }
+    }
+    // Многочлены на [-pi/4, pi/4]: для float - из cephes, для double - из fdlibm.
+    template <typename T>
+    inline SinCos<T> sincos_kernel(double r) {
+        if constexpr (sizeof(T) <= sizeof(float)) {
+            float x = r, z = x * x;
+            float s = x + x * z * (-1.6666654611e-1f + z * (8.3321608736e-3f + z * -1.9515295891e-4f));
+            float c = 1 - 0.5f * z + z * z * (4.166664568298827e-2f + z * (-1.388731625493765e-3f + z * 2.443315711809948e-5f));
+            return {s, c};
+        }
+        else {
+            double z = r * r;
+            double s = r + r * z * (-1.66666666666666324348e-01 + z * (8.33333333332248946124e-03
+                + z * (-1.98412698298579493134e-04 + z * (2.75573137070700676789e-06
+                + z * (-2.50507602534068634195e-08 + z * 1.58969099521155010221e-10)))));
+            double c = 1 - 0.5 * z + z * z * (4.16666666666666019037e-02 + z * (-1.38888888888741095749e-03
+                + z * (2.48015872894767294178e-05 + z * (-2.75573143513906633035e-07
+                + z * (2.08757232129817482790e-09 + z * -1.13596475577881948265e-11)))));
+            return {T(s), T(c)};
+        }
+    }
+    // Сдвиг на четверть оборота: sin и cos меняются местами и знаками. В
+    // векторизуемом цикле выбор - это маски, а в скалярном коде тернарный
+    // оператор над float стал бы ветвлением, которое для случайных углов
+    // ошибается через раз, поэтому там значение берётся по индексу.
+    template <typename T, bool vectorized>
+    inline SinCos<T> rotate_quadrant(SinCos<T> v, int quadrant) {
+        bool swap = quadrant & 1, neg_sin = quadrant & 2, neg_cos = (quadrant + 1) & 2;
+        if constexpr (vectorized) {
+            T s = swap ? v.cos : v.sin, c = swap ? v.sin : v.cos;
+            return {neg_sin ? -s : s, neg_cos ? -c : c};
+        }
+        else {
+            T values[2] = {v.sin, v.cos};
+            T signs[2] = {1, -1};
+            return {signs[neg_sin] * values[swap], signs[neg_cos] * values[!swap]};
+        }
+    }
+    template <typename T, bool vectorized = false>
+    inline SinCos<T> sincos_fast(T x) {
+        int quadrant;
+        double r = reduce_quadrant<T>(x, quadrant);
+        return rotate_quadrant<T, vectorized>(sincos_kernel<T>(r), quadrant);
+    }
+
+    constexpr int trig_table_size = 2048;
+    // Пары sin, cos в узлах 2pi * i / trig_table_size.
+    template <typename T>
+    const T* trig_table() {
+        static const std::vector<T> table = [] {
+            std::vector<T> values(2 * trig_table_size);
+            for (int i = 0; i < trig_table_size; ++i) {
+                double a = 6.283185307179586476925 * i / trig_table_size;
+                values[2 * i] = std::sin(a);
+                values[2 * i + 1] = std::cos(a);
+            }
+            return values;
+        }();
+        return table.data();
+    }
+    // Ближайший узел и sin(a + d) ~ sin a + d cos a, cos(a + d) ~ cos a - d sin a при |d| <= pi / size.
+    template <typename T>
+    inline SinCos<T> sincos_table(T x, const T* table) {
+        double t = x * (trig_table_size / 6.283185307179586476925);
+        double k = (t + round_shifter) - round_shifter;
+        int i = static_cast<int>(k) & (trig_table_size - 1);
+        T d = (t - k) * (6.283185307179586476925 / trig_table_size);
+        T s = table[2 * i], c = table[2 * i + 1];
+        return {s + d * c, c - d * s};
+    }
+
+    // Угол вектора (x, y) в [0, 2pi): отношение меньшей координаты к большей
+    // сводится к [0, tan(pi/8)] и подставляется в многочлен atanf из cephes.
+    // Октант восстанавливается как offset + sign * r, где выбираются только
+    // константы, чтобы цикл по массиву векторизовался.
+    template <typename T>
+    inline T atan2_fast(T y, T x) {
+        constexpr T pi = 3.141592653589793238462643383279502884L;
+        T ax = std::fabs(x), ay = std::fabs(y);
+        bool steep = ay > ax;
+        T hi = steep ? ay : ax, lo = steep ? ax : ay;
+        T a = lo / (hi + (hi == 0 ? T(1) : T(0)));
+        // При a > tan(pi/8) берётся t = (a - 1) / (a + 1), иначе t = a. Выбор
+        // умножением на маску: тернарный оператор GCC разводит по веткам.
+        T upper = a > T(0.414213562373095048802) ? T(1) : T(0);
+        T t = a + upper * ((a - 1) / (a + 1) - a);
+        T z = t * t;
+        T r = (((T(8.05374449538e-2) * z - T(1.38776856032e-1)) * z + T(1.99777106478e-1)) * z
+            - T(3.33329491539e-1)) * z * t + t;
+        r = r + upper * (pi / 4);
+        r = (steep ? pi / 2 : T(0)) + (steep ? T(-1) : T(1)) * r;
+        r = (x < 0 ? pi : T(0)) + (x < 0 ? T(-1) : T(1)) * r;
+        r = (y < 0 ? 2 * pi : T(0)) + (y < 0 ? T(-1) : T(1)) * r;
+        // 2pi - r при малом r округляется до 2pi; min возвращает его в [0, 2pi)
+        // и, в отличие от выбора 0, не мешает векторизации.
+        return std::min(r, std::nextafter(T(2 * pi), T(0)));
+    }
+
+    // Пакетное вычисление по блокам, как в normalize_block: если весь блок
+    // внутри trig_limit, цикл без ветвлений векторизуется, иначе элементы
+    // разбираются по одному.
+    template <typename T, typename Kernel, typename Store, typename Exact>
+    void trig_batch(std::span<const T> rad, Kernel kernel, Store store, Exact exact) {
+        constexpr std::size_t block = 256;
+        for (std::size_t offset = 0; offset < rad.size(); offset += block) {
+            std::size_t n = std::min(block, rad.size() - offset);
+            const T* x = rad.data() + offset;
+            int inside = 1;
+            for (std::size_t i = 0; i < n; ++i) { inside &= std::fabs(x[i]) <= T(trig_limit); }
+            if (inside) {
+                for (std::size_t i = 0; i < n; ++i) { store(offset + i, kernel(x[i])); }
+                continue;
+            }
+            for (std::size_t i = 0; i < n; ++i) {
+                if (std::fabs(x[i]) <= T(trig_limit)) { store(offset + i, kernel(x[i])); }
+                else { exact(offset + i, x[i]); }
+            }
+        }
+    }
+}
+
+
+// Вычисления ведутся не менее чем в double, хранение - в T.
+template <typename T>
+class BasicAngle {
+    T m_rad;
+
+    // Для atan2 из [-pi, pi] fmod в normalize не нужен: достаточно прибавить 2pi.
+    // + 0 превращает -0 в 0; малый отрицательный угол после + 2pi
+    // округляется в T до 2pi и заменяется ближайшим углом 0.
+    static T atan2_normalized(T y, T x) {
+        T rad = std::atan2(y, x) + T(0);
+        if (rad < 0) { rad = static_cast<T>(rad + 2 * pi); }
+        return calc_type(rad) < 2 * pi ? rad : T(0);
+    }
+    bool use_fast_trig() const { return detail::has_fast_trig<T> && std::fabs(m_rad) <= T(detail::trig_limit); }
+    // Общая часть пакетных sin, cos, sincos и tan; store получает индекс и пару sin, cos.
+    template <typename Store>
+    static void trig(std::span<const T> rad, TrigAccuracy accuracy, Store store) {
+        auto exact = [&](std::size_t i, T x) {
+            store(i, SinCos<T>{std::sin(x), std::cos(x)});
+        };
+        if (accuracy == TrigAccuracy::exact || !detail::has_fast_trig<T>) {
+            for (std::size_t i = 0; i < rad.size(); ++i) { exact(i, rad[i]); }
+        }
+        else if (accuracy == TrigAccuracy::table) {
+            const T* table = detail::trig_table<T>();
+            detail::trig_batch(rad, [table](T x) { return detail::sincos_table(x, table); }, store, exact);
+        }
+        else { detail::trig_batch(rad, [](T x) { return detail::sincos_fast<T, true>(x); }, store, exact); }
+    }
+public:
+    using value_type = T;
+    using calc_type = std::common_type_t<T, double>;
+    static constexpr calc_type pi = static_cast<calc_type>(3.141592653589793238462643383279502884L);
+    constexpr BasicAngle(): m_rad(0) {}
+    constexpr BasicAngle(T rad): m_rad(rad) {}
+    static constexpr T normalize(T angle_rad) {
+        calc_type rad = angle_rad;
+        if (rad >= 0 && rad < 2 * pi) { return angle_rad; }
+        rad = std::is_constant_evaluated() ? detail::constexpr_fmod(rad, 2 * pi) : std::fmod(rad, 2 * pi);
+        if (rad < 0) { rad += 2 * pi; }
+        // -x при малом x округляется в T до 2pi; ближайший к нему угол из [0, 2pi) - это 0.
+        T result = static_cast<T>(rad);
+        return calc_type(result) < 2 * pi ? result : T(0);
+    }
+    static constexpr BasicAngle from_radians(T rad) { return BasicAngle(rad); }
+    static constexpr BasicAngle from_degrees(T deg) { return BasicAngle(deg * pi / 180); }
+    T sin(TrigAccuracy accuracy = TrigAccuracy::exact) const {
+        if (accuracy == TrigAccuracy::exact || !use_fast_trig()) { return std::sin(m_rad); }
+        return sincos(accuracy).sin;
+    }
+    T cos(TrigAccuracy accuracy = TrigAccuracy::exact) const {
+        if (accuracy == TrigAccuracy::exact || !use_fast_trig()) { return std::cos(m_rad); }
+        return sincos(accuracy).cos;
+    }
+    // Синус и косинус с общим приведением аргумента.
+    SinCos<T> sincos(TrigAccuracy accuracy = TrigAccuracy::exact) const {
+        if (accuracy == TrigAccuracy::exact || !use_fast_trig()) {
+            return {std::sin(m_rad), std::cos(m_rad)};
+        }
+        if (accuracy == TrigAccuracy::table) { return detail::sincos_table(m_rad, detail::trig_table<T>()); }
+        return detail::sincos_fast(m_rad);
+    }
+    T tan(TrigAccuracy accuracy = TrigAccuracy::exact) const {
+        if (accuracy == TrigAccuracy::exact || !use_fast_trig()) { return std::tan(m_rad); }
+        SinCos<T> v = sincos(accuracy);
+        return v.sin / v.cos;
+    }
+    static void sincos(std::span<const T> rad, std::span<T> sin, std::span<T> cos,
+        TrigAccuracy accuracy = TrigAccuracy::exact) {
+        if (sin.size() < rad.size() || cos.size() < rad.size()) { throw std::invalid_argument("Output is too small"); }
+        trig(rad, accuracy, [&](std::size_t i, SinCos<T> v) {
+            sin[i] = v.sin;
+            cos[i] = v.cos;
+        });
+    }
+    static void sin(std::span<const T> rad, std::span<T> out, TrigAccuracy accuracy = TrigAccuracy::exact) {
+        if (out.size() < rad.size()) { throw std::invalid_argument("Output is too small"); }
+        if (accuracy == TrigAccuracy::exact) {
+            for (std::size_t i = 0; i < rad.size(); ++i) { out[i] = std::sin(rad[i]); }
+            return;
+        }
+        trig(rad, accuracy, [&](std::size_t i, SinCos<T> v) { out[i] = v.sin; });
+    }
+    static void cos(std::span<const T> rad, std::span<T> out, TrigAccuracy accuracy = TrigAccuracy::exact) {
+        if (out.size() < rad.size()) { throw std::invalid_argument("Output is too small"); }
+        if (accuracy == TrigAccuracy::exact) {
+            for (std::size_t i = 0; i < rad.size(); ++i) { out[i] = std::cos(rad[i]); }
+            return;
+        }
+        trig(rad, accuracy, [&](std::size_t i, SinCos<T> v) { out[i] = v.cos; });
+    }
+    static void tan(std::span<const T> rad, std::span<T> out, TrigAccuracy accuracy = TrigAccuracy::exact) {
+        if (out.size() < rad.size()) { throw std::invalid_argument("Output is too small"); }
+        if (accuracy == TrigAccuracy::exact) {
+            for (std::size_t i = 0; i < rad.size(); ++i) { out[i] = std::tan(rad[i]); }
+            return;
+        }
+        trig(rad, accuracy, [&](std::size_t i, SinCos<T> v) { out[i] = v.sin / v.cos; });
+    }
+    // Направление вектора (x, y), сразу приведённое к [0, 2pi); exact - это
+    // from_radians(std::atan2(y, x)).normalize() одним вызовом.
+    static BasicAngle from_vector(T x, T y, TrigAccuracy accuracy = TrigAccuracy::exact) {
+        if (accuracy == TrigAccuracy::exact) { return BasicAngle(atan2_normalized(y, x)); }
+        return BasicAngle(detail::atan2_fast(y, x));
+    }
+    static void from_vector(std::span<const T> x, std::span<const T> y, std::span<T> rad,
+        TrigAccuracy accuracy = TrigAccuracy::exact) {
+        if (y.size() != x.size()) { throw std::invalid_argument("Coordinate arrays differ in size"); }
+        if (rad.size() < x.size()) { throw std::invalid_argument("Output is too small"); }
+        if (accuracy == TrigAccuracy::exact) {
+            for (std::size_t i = 0; i < x.size(); ++i) { rad[i] = atan2_normalized(y[i], x[i]); }
+            return;
+        }
+        const T* px = x.data();
+        const T* py = y.data();
+        T* out = rad.data();
+        for (std::size_t i = 0; i < x.size(); ++i) { out[i] = detail::atan2_fast(py[i], px[i]); }
+    }
+    // Массив углов устроен как массив T, поэтому в байты и обратно - без поэлементного копирования.
+    static std::span<const std::byte> to_bytes(std::span<const BasicAngle> values) { return std::as_bytes(values); }
+    static std::size_t from_bytes(std::span<const std::byte> bytes, std::span<BasicAngle> out) {
+        return detail::copy_from_bytes(bytes, out);
+    }
+    constexpr T getRadians() const { return m_rad; }
+    int getDegrees() const { return std::round(m_rad * calc_type(180) / pi); }
+    constexpr BasicAngle& setRadians(T rad) {
+        m_rad = rad;
+        return *this;
+    }
+    constexpr BasicAngle& setDegrees(T deg) {
+        m_rad = deg * pi / 180;
+        return *this;
+    }
+    constexpr explicit operator T() const { return m_rad; }
+    constexpr explicit operator int() const { return static_cast<int>(m_rad); }
+    operator std::string() const {
+        char buffer[detail::radians_size<T>];
+        return std::string(buffer, detail::write_radians(buffer, buffer + sizeof(buffer), m_rad).ptr);
+    }
+    constexpr BasicAngle operator+(const BasicAngle& other) const { return BasicAngle(m_rad + other.m_rad); }
+    constexpr BasicAngle operator+(T rad) const { return BasicAngle(m_rad + rad); }
+    constexpr BasicAngle operator-(const BasicAngle& other) const { return BasicAngle(m_rad - other.m_rad); }
+    constexpr BasicAngle operator-(T rad) const { return BasicAngle(m_rad - rad); }
+    constexpr BasicAngle operator*(T factor) const { return BasicAngle(m_rad * factor); }
+    constexpr BasicAngle operator/(T divisor) const {
+        if (divisor == 0) { throw std::invalid_argument("Division by zero"); }
+        return BasicAngle(m_rad / divisor);
+    }
+    static constexpr std::size_t max_str_size = 16;
+    static constexpr std::size_t max_repr_size = detail::radians_size<T> + 12;
+    // Запись str() и repr() в буфер вызывающего без выделения памяти.
+    std::to_chars_result to_chars(char* first, char* last) const {
+        std::to_chars_result result = std::to_chars(first, last, getDegrees());
+        if (result.ec != std::errc()) { return result; }
+        return detail::write_text(result.ptr, last, " deg");
+    }
+    std::to_chars_result repr_to_chars(char* first, char* last) const {
+        std::to_chars_result result = detail::write_text(first, last, "Angle(");
+        if (result.ec == std::errc()) { result = detail::write_radians(result.ptr, last, m_rad); }
+        if (result.ec == std::errc()) { result = detail::write_text(result.ptr, last, " rad)"); }
+        return result;
+    }
+    // Разбор того, что пишут str() и repr(): "45 deg", "Angle(0.785398 rad)", а
+    // также числа с единицей "1.5 rad" или "30deg". Ошибки - через ec, как у
+    // std::from_chars; при ошибке ptr == first и out не меняется.
+    static std::from_chars_result parse(const char* first, const char* last, BasicAngle& out) {
+        const char* ptr = first;
+        bool wrapped = detail::consume(ptr, last, "Angle(");
+        T value;
+        std::from_chars_result number = detail::parse_number(ptr, last, value);
+        if (number.ec != std::errc()) { return {first, number.ec}; }
+        ptr = detail::skip_spaces(number.ptr, last);
+        bool degrees = detail::consume(ptr, last, "deg");
+        if (!degrees && !detail::consume(ptr, last, "rad")) { return {first, std::errc::invalid_argument}; }
+        if (wrapped && !detail::consume(ptr, last, ")")) { return {first, std::errc::invalid_argument}; }
+        out = degrees ? from_degrees(value) : from_radians(value);
+        return {ptr, std::errc()};
+    }
+    static std::from_chars_result parse(std::string_view text, BasicAngle& out) {
+        return parse(text.data(), text.data() + text.size(), out);
+    }
+    std::string str() const {
+        char buffer[max_str_size];
+        return std::string(buffer, to_chars(buffer, buffer + max_str_size).ptr);
+    }
+    std::string repr() const {
+        char buffer[max_repr_size];
+        return std::string(buffer, repr_to_chars(buffer, buffer + max_repr_size).ptr);
+    }
+    friend std::ostream& operator<<(std::ostream& os, const BasicAngle& angle) {
+        char buffer[max_str_size];
+        return os.write(buffer, angle.to_chars(buffer, buffer + max_str_size).ptr - buffer);
+    }
+    constexpr bool operator==(const BasicAngle& other) const {
+        T diff = normalize(m_rad) - normalize(other.m_rad);
+        return diff < T(1e-6) && -diff < T(1e-6);
+    }
+    constexpr bool operator!=(const BasicAngle& other) const {
+        return !(*this == other);
+    }
+    constexpr bool operator<(const BasicAngle& other) const {
+        return normalize(m_rad) < normalize(other.m_rad);
+    }
+    constexpr bool operator>(const BasicAngle& other) const {
+        return normalize(m_rad) > normalize(other.m_rad);
+    }
+    constexpr bool operator<=(const BasicAngle& other) const {
+        return !(*this > other);
+    }
+    constexpr bool operator>=(const BasicAngle& other) const {
+        return !(*this < other);
+    }
+    friend constexpr BasicAngle operator+(T rad, const BasicAngle& other) { return BasicAngle(rad + other.m_rad); }
+    friend constexpr BasicAngle operator-(T rad, const BasicAngle& other) { return BasicAngle(rad - other.m_rad); }
+    friend constexpr BasicAngle operator*(T factor, const BasicAngle& other) { return BasicAngle(factor * other.m_rad); }
+};
+
+using Angle = BasicAngle<float>;
+static_assert(std::is_trivially_copyable_v<Angle> && std::is_standard_layout_v<Angle>);
+static_assert(sizeof(Angle) == sizeof(float));
+
+
+namespace detail {
+    constexpr std::size_t normalize_block_size = 256;
+
+    // Для x из (-2pi, 4pi) fmod(x, 2pi) равен x или x - 2pi точно, поэтому
+    // fmod вызывается только для блоков, где встретились другие значения.
+    // Единственное отличие от BasicAngle::normalize: -0 становится +0.
+    template <typename T>
+    void normalize_block(const T* in, T* out, std::size_t n) {
+        using calc_type = typename BasicAngle<T>::calc_type;
+        constexpr calc_type two_pi = 2 * BasicAngle<T>::pi;
+        constexpr T narrow_low = -two_pi * 0.999999;
+        constexpr T narrow_high = 2 * two_pi * 0.999999;
+        int narrow = 1;
+        for (std::size_t i = 0; i < n; ++i) { narrow &= (in[i] > narrow_low) & (in[i] < narrow_high); }
+        if (!narrow) {
+            for (std::size_t i = 0; i < n; ++i) { out[i] = BasicAngle<T>::normalize(in[i]); }
+            return;
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            calc_type rad = in[i];
+            calc_type low = rad < 0 ? two_pi : calc_type(0);
+            calc_type high = rad >= two_pi ? two_pi : calc_type(0);
+            T result = static_cast<T>((rad + low) - high);
+            out[i] = calc_type(result) < two_pi ? result : T(0);
+        }
+    }
+}
+
+
+
+// Угол, приведённый к [0, 2pi) один раз при создании: сравнения не вызывают fmod.
+template <typename T>
+class BasicNormalizedAngle {
+    T m_rad;
+public:
+    using value_type = T;
+    constexpr BasicNormalizedAngle(): m_rad(0) {}
+    constexpr BasicNormalizedAngle(const BasicAngle<T>& angle): m_rad(BasicAngle<T>::normalize(angle.getRadians())) {}
+    static constexpr BasicNormalizedAngle from_radians(T rad) { return BasicNormalizedAngle(BasicAngle<T>(rad)); }
+    static constexpr BasicNormalizedAngle from_degrees(T deg) { return BasicNormalizedAngle(BasicAngle<T>::from_degrees(deg)); }
+    constexpr T getRadians() const { return m_rad; }
+    int getDegrees() const { return std::round(m_rad * typename BasicAngle<T>::calc_type(180) / BasicAngle<T>::pi); }
+    constexpr operator BasicAngle<T>() const { return BasicAngle<T>(m_rad); }
+    constexpr BasicNormalizedAngle operator+(const BasicNormalizedAngle& other) const {
+        return BasicNormalizedAngle(BasicAngle<T>(m_rad + other.m_rad));
+    }
+    constexpr BasicNormalizedAngle operator-(const BasicNormalizedAngle& other) const {
+        return BasicNormalizedAngle(BasicAngle<T>(m_rad - other.m_rad));
+    }
+    static constexpr std::size_t max_str_size = BasicAngle<T>::max_str_size;
+    static constexpr std::size_t max_repr_size = detail::radians_size<T> + 22;
+    std::to_chars_result to_chars(char* first, char* last) const {
+        std::to_chars_result result = std::to_chars(first, last, getDegrees());
+        if (result.ec != std::errc()) { return result; }
+        return detail::write_text(result.ptr, last, " deg");
+    }
+    std::to_chars_result repr_to_chars(char* first, char* last) const {
+        std::to_chars_result result = detail::write_text(first, last, "NormalizedAngle(");
+        if (result.ec == std::errc()) { result = detail::write_radians(result.ptr, last, m_rad); }
+        if (result.ec == std::errc()) { result = detail::write_text(result.ptr, last, " rad)"); }
+        return result;
+    }
+    std::string str() const {
+        char buffer[max_str_size];
+        return std::string(buffer, to_chars(buffer, buffer + max_str_size).ptr);
+    }
+    std::string repr() const {
+        char buffer[max_repr_size];
+        return std::string(buffer, repr_to_chars(buffer, buffer + max_repr_size).ptr);
+    }
+    friend std::ostream& operator<<(std::ostream& os, const BasicNormalizedAngle& angle) {
+        char buffer[max_str_size];
+        return os.write(buffer, angle.to_chars(buffer, buffer + max_str_size).ptr - buffer);
+    }
+    constexpr bool operator==(const BasicNormalizedAngle& other) const {
+        return m_rad - other.m_rad < T(1e-6) && other.m_rad - m_rad < T(1e-6);
+    }
+    constexpr bool operator!=(const BasicNormalizedAngle& other) const { return !(*this == other); }
+    constexpr bool operator<(const BasicNormalizedAngle& other) const { return m_rad < other.m_rad; }
+    constexpr bool operator>(const BasicNormalizedAngle& other) const { return m_rad > other.m_rad; }
+    constexpr bool operator<=(const BasicNormalizedAngle& other) const { return !(m_rad > other.m_rad); }
+    constexpr bool operator>=(const BasicNormalizedAngle& other) const { return !(m_rad < other.m_rad); }
+};
+
+using NormalizedAngle = BasicNormalizedAngle<float>;
+static_assert(std::is_trivially_copyable_v<NormalizedAngle> && std::is_standard_layout_v<NormalizedAngle>);
+
+
+namespace detail {
+    // Граница на окружности, разрезанной в нуле: (x, false) стоит перед точкой x,
+    // (x, true) - сразу после неё. Тогда любая дуга с любыми концами - это
+    // полуинтервал [lo, hi) из таких границ, и включённость концов не требует
+    // отдельных случаев.
+    template <typename T>
+    struct ArcBound {
+        T rad;
+        bool after;
+        constexpr bool operator==(const ArcBound& other) const { return rad == other.rad && after == other.after; }
+        constexpr bool operator<(const ArcBound& other) const {
+            return rad < other.rad || (rad == other.rad && !after && other.after);
+        }
+        constexpr bool operator<=(const ArcBound& other) const { return !(other < *this); }
+        static constexpr ArcBound begin() { return ArcBound{0, false}; }
+        static constexpr ArcBound end() { return ArcBound{std::numeric_limits<T>::infinity(), false}; }
+    };
+
+    template <typename T>
+    struct ArcInterval {
+        ArcBound<T> lo;
+        ArcBound<T> hi;
+        constexpr bool operator==(const ArcInterval& other) const { return lo == other.lo && hi == other.hi; }
+        static constexpr ArcInterval circle() { return ArcInterval{ArcBound<T>::begin(), ArcBound<T>::end()}; }
+    };
+
+    // Следующее за x число типа T для 0 <= x < 8. В константном выражении
+    // nextafter недоступен, и шаг ищется делением: x + step / 2 округляется к x.
+    template <typename T>
+    constexpr T next_up(T x) {
+        if (!std::is_constant_evaluated()) { return std::nextafter(x, std::numeric_limits<T>::infinity()); }
+        T step = 8 * std::numeric_limits<T>::epsilon();
+        while (x + step / 2 > x) { step /= 2; }
+        return x + step;
+    }
+    // Та же граница для углов типа T, но без after: (x, true) - это
+    // (next_up(x), false), а граница от 2pi и дальше - это end(). Куски из
+    // таких границ сравниваются как множества углов: между (a, true) и
+    // (next_up(a), false) угла нет, хотя как границы они различны.
+    template <typename T>
+    constexpr ArcBound<T> canonical(const ArcBound<T>& bound) {
+        T rad = bound.after ? next_up(bound.rad) : bound.rad;
+        if (typename BasicAngle<T>::calc_type(rad) >= 2 * BasicAngle<T>::pi) { return ArcBound<T>::end(); }
+        return ArcBound<T>{rad, false};
+    }
+    // Первый угол типа T из [0, 2pi) внутри куска. Его может не быть, например
+    // у (a, next_up(a)) или у куска после наибольшего числа, меньшего 2pi:
+    // такой кусок не содержит ни одного угла.
+    template <typename T>
+    constexpr bool first_angle(const ArcInterval<T>& part, T& point) {
+        ArcBound<T> lo = canonical(part.lo);
+        point = lo.rad;
+        return lo < canonical(part.hi);
+    }
+
+    // Вектор с ёмкостью N на стеке - для результатов, размер которых ограничен заранее.
+    // Элементы хранятся в union и создаются только при push_back, так что T
+    // может не иметь конструктора по умолчанию; T тривиально уничтожаемый.
+    template <typename T, std::size_t N>
+    class FixedVector {
+        static_assert(std::is_trivially_destructible_v<T>);
+        union {
+            char m_none = 0;
+            T m_items[N];
+        };
+        std::size_t m_size = 0;
+    public:
+        constexpr FixedVector() {}
+        // Вместимость - инвариант вызывающего кода (операции над двумя дугами
+        // дают не больше двух кусков), поэтому проверка только в отладке.
+        constexpr void push_back(const T& item) {
+            assert(m_size < N);
+            std::construct_at(m_items + m_size++, item);
+        }
+        constexpr std::size_t size() const { return m_size; }
+        constexpr bool empty() const { return m_size == 0; }
+        constexpr const T* data() const { return m_items; }
+        constexpr const T& operator[](std::size_t i) const { return m_items[i]; }
+        constexpr const T* begin() const { return m_items; }
+        constexpr const T* end() const { return m_items + m_size; }
+    };
+
+    // Слияние двух упорядоченных списков непересекающихся полуинтервалов:
+    // op(в a, в b) задаёт операцию, в out попадает результат без касающихся кусков.
+    template <typename T, typename Op, typename Out>
+    void combine_intervals(const ArcInterval<T>* a, std::size_t na,
+                           const ArcInterval<T>* b, std::size_t nb, Op op, Out& out) {
+        auto bound = [](const ArcInterval<T>* list, std::size_t k) { return k % 2 ? list[k / 2].hi : list[k / 2].lo; };
+        std::size_t i = 0, j = 0;
+        bool inside = false;
+        ArcBound<T> open{};
+        while (i < 2 * na || j < 2 * nb) {
+            ArcBound<T> next = (j == 2 * nb || (i < 2 * na && bound(a, i) < bound(b, j))) ? bound(a, i) : bound(b, j);
+            while (i < 2 * na && bound(a, i) == next) { ++i; }
+            while (j < 2 * nb && bound(b, j) == next) { ++j; }
+            bool now = op(i % 2 == 1, j % 2 == 1);
+            if (now == inside) { continue; }
+            if (now) { open = next; }
+            else { out.push_back(ArcInterval<T>{open, next}); }
+            inside = now;
+        }
+    }
+}
+
+
+
+template <typename T>
+class BasicAngleRange {
+    using Angle = BasicAngle<T>;
+    using NormalizedAngle = BasicNormalizedAngle<T>;
+    using AngleRange = BasicAngleRange;
+    using Bound = detail::ArcBound<T>;
+    using Interval = detail::ArcInterval<T>;
+    Angle m_start;
+    Angle m_end;
+    bool m_in_start;
+    bool m_in_end;
+    // Границы сравниваются как в contains(const Angle&): x >= start записано
+    // как !(x < start), чтобы совпадать с ним и на NaN.
+    void contains_block(const T* rad, uint8_t* mask, std::size_t n) const {
+        T start = Angle::normalize(m_start.getRadians());
+        T end = Angle::normalize(m_end.getRadians());
+        uint8_t in_start = m_in_start, in_end = m_in_end;
+        if (is_full()) {
+            uint8_t in_any = in_start | in_end;
+            for (std::size_t i = 0; i < n; ++i) { mask[i] = (rad[i] != start) | in_any; }
+            return;
+        }
+        if (start <= end) {
+            for (std::size_t i = 0; i < n; ++i) {
+                uint8_t left = (rad[i] > start) | (in_start & !(rad[i] < start));
+                uint8_t right = (rad[i] < end) | (in_end & !(rad[i] > end));
+                mask[i] = left & right;
+            }
+            return;
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            uint8_t left = (rad[i] > start) | (in_start & !(rad[i] < start));
+            uint8_t right = (rad[i] < end) | (in_end & !(rad[i] > end));
+            mask[i] = left | right;
+        }
+    }
+    // Принадлежность уже приведённого к [0, 2pi) угла.
+    constexpr bool contains_normalized(T rad) const {
+        T start = Angle::normalize(m_start.getRadians());
+        if (is_full()) { return rad != start || m_in_start || m_in_end; }
+        T end = Angle::normalize(m_end.getRadians());
+        bool left_ok = m_in_start ? !(rad < start) : (rad > start);
+        bool right_ok = m_in_end ? !(rad > end) : (rad < end);
+        return start <= end ? (left_ok && right_ok) : (left_ok || right_ok);
+    }
+    template <typename Op>
+    auto combine(const AngleRange& other, Op op) const {
+        Interval mine[2], theirs[2];
+        std::size_t mine_count = to_intervals(mine), theirs_count = other.to_intervals(theirs);
+        detail::FixedVector<Interval, 4> parts;
+        detail::combine_intervals(mine, mine_count, theirs, theirs_count, op, parts);
+        Pieces result;
+        from_intervals(parts.data(), parts.size(), result);
+        return result;
+    }
+public:
+    using value_type = T;
+    using calc_type = typename Angle::calc_type;
+    // Результат операций над двумя дугами: на окружности это не больше двух
+    // дуг, и они хранятся на месте, без выделения памяти.
+    using Pieces = detail::FixedVector<AngleRange, 2>;
+    constexpr BasicAngleRange(const Angle& start,
+        const Angle& end,
+        bool in_start = true,
+        bool in_end = true):
+        m_start(start), m_end(end), m_in_start(in_start), m_in_end(in_end) {}
+    constexpr BasicAngleRange(T start_rad, T end_rad, bool in_start = true, bool in_end = true):
+        m_start(Angle::from_radians(start_rad)), m_end(Angle::from_radians(end_rad)),
+        m_in_start(in_start), m_in_end(in_end) {}
+    static AngleRange full(const Angle& start = Angle(), bool in_start = true, bool in_end = true) {
+        T start_rad = start.getRadians();
+        T end_rad = static_cast<T>(start_rad + 2 * Angle::pi);
+        while (calc_type(end_rad) - start_rad < 2 * Angle::pi) {
+            end_rad = std::nextafter(end_rad, std::numeric_limits<T>::infinity());
+        }
+        return AngleRange(start, Angle(end_rad), in_start, in_end);
+    }
+    // Байты массива дуг включают выравнивание после флагов, так что годятся
+    // для обмена внутри процесса; для хранения на диске есть angle_file.h.
+    static std::span<const std::byte> to_bytes(std::span<const AngleRange> values) { return std::as_bytes(values); }
+    static std::size_t from_bytes(std::span<const std::byte> bytes, std::span<AngleRange> out) {
+        return detail::copy_from_bytes(bytes, out);
+    }
+    constexpr Angle getStart() const { return m_start; }
+    constexpr Angle getEnd() const { return m_end; }
+    constexpr bool includesStart() const { return m_in_start; }
+    constexpr bool includesEnd() const { return m_in_end; }
+    // Диапазон идёт от start против часовой стрелки до end; если end дальше
+    // start на полный оборот и больше, это вся окружность, а точка start
+    // исключается, только когда исключены оба конца.
+    constexpr bool is_full() const {
+        return calc_type(m_end.getRadians()) - m_start.getRadians() >= 2 * Angle::pi;
+    }
+    // Разбиение дуги на не более чем два полуинтервала внутри [0, 2pi) по возрастанию.
+    constexpr std::size_t to_intervals(Interval* out) const {
+        T start = Angle::normalize(m_start.getRadians());
+        std::size_t count = 0;
+        if (is_full()) {
+            if (m_in_start || m_in_end) {
+                out[count++] = Interval::circle();
+                return count;
+            }
+            if (Bound::begin() < Bound{start, false}) { out[count++] = Interval{Bound::begin(), Bound{start, false}}; }
+            out[count++] = Interval{Bound{start, true}, Bound::end()};
+            return count;
+        }
+        T end = Angle::normalize(m_end.getRadians());
+        Bound lo{start, !m_in_start}, hi{end, m_in_end};
+        if (start <= end) {
+            if (lo < hi) { out[count++] = Interval{lo, hi}; }
+            return count;
+        }
+        if (Bound::begin() < hi) { out[count++] = Interval{Bound::begin(), hi}; }
+        out[count++] = Interval{lo, Bound::end()};
+        return count;
+    }
+    // Обратное преобразование: куски, касающиеся 0 с двух сторон, склеиваются в одну дугу.
+    template <typename Out>
+    static void from_intervals(const Interval* parts, std::size_t n, Out& out) {
+        if (n == 0) { return; }
+        std::size_t first = 0, last = n;
+        if (parts[0] == Interval::circle()) {
+            out.push_back(full());
+            return;
+        }
+        if (n > 1 && parts[0].lo == Bound::begin() && parts[n - 1].hi == Bound::end()) {
+            const Bound& lo = parts[n - 1].lo;
+            const Bound& hi = parts[0].hi;
+            if (lo.rad == hi.rad) { out.push_back(full(Angle(lo.rad), false, false)); }
+            else { out.push_back(AngleRange(lo.rad, hi.rad, !lo.after, hi.after)); }
+            first = 1;
+            last = n - 1;
+        }
+        for (std::size_t i = first; i < last; ++i) {
+            const Interval& part = parts[i];
+            if (!(part.hi == Bound::end())) {
+                out.push_back(AngleRange(part.lo.rad, part.hi.rad, !part.lo.after, part.hi.after));
+            }
+            else if (part.lo.rad == 0) { out.push_back(full(Angle(), false, false)); }
+            else { out.push_back(AngleRange(part.lo.rad, 0, !part.lo.after, false)); }
+        }
+    }
+    constexpr calc_type length() const {
+        if (is_full()) { return 2 * Angle::pi; }
+        calc_type len = calc_type(Angle::normalize(m_end.getRadians())) - Angle::normalize(m_start.getRadians());
+        if (len < 0) { len += 2 * Angle::pi; }
+        return len;
+    }
+    // Концы сравниваются с допуском, как углы. Полные окружности равны, если
+    // совпадает исключённая точка start (или её нет у обеих), и не равны
+    // никакой неполной дуге, даже с теми же концами.
+    constexpr bool operator==(const AngleRange& other) const {
+        if (is_full() != other.is_full()) { return false; }
+        if (is_full()) {
+            bool whole = m_in_start || m_in_end;
+            return whole == (other.m_in_start || other.m_in_end) && (whole || m_start == other.m_start);
+        }
+        return m_start == other.m_start && m_end == other.m_end
+            && m_in_start == other.m_in_start && m_in_end == other.m_in_end;
+    }
+    constexpr bool operator!=(const AngleRange& other) const { return !(*this == other); }
+    constexpr bool contains(const Angle& other) const {
+        return contains_normalized(Angle::normalize(other.getRadians()));
+    }
+    constexpr bool contains(const NormalizedAngle& other) const {
+        return contains_normalized(other.getRadians());
+    }
+    // Сравниваются множества углов типа T: границы приводятся к canonical,
+    // пустые куски пропускаются, а свои куски, между которыми нет ни одного
+    // угла, склеиваются.
+    constexpr bool contains(const AngleRange& other) const {
+        Interval mine[2] = {}, theirs[2];
+        std::size_t mine_count = to_intervals(mine), theirs_count = other.to_intervals(theirs);
+        for (std::size_t j = 0; j < 2; ++j) { mine[j] = Interval{detail::canonical(mine[j].lo), detail::canonical(mine[j].hi)}; }
+        if (mine_count == 2 && mine[0].hi == mine[1].lo) { mine[0].hi = mine[--mine_count].hi; }
+        for (std::size_t i = 0; i < theirs_count; ++i) {
+            Bound lo = detail::canonical(theirs[i].lo), hi = detail::canonical(theirs[i].hi);
+            if (!(lo < hi)) { continue; }
+            bool covered = false;
+            for (std::size_t j = 0; j < mine_count; ++j) { covered |= mine[j].lo <= lo && hi <= mine[j].hi; }
+            if (!covered) { return false; }
+        }
+        return true;
+    }
+    void contains(std::span<const T> rad, std::span<uint8_t> mask) const {
+        if (mask.size() < rad.size()) { throw std::invalid_argument("Mask is too small"); }
+        T tmp[detail::normalize_block_size];
+        for (std::size_t offset = 0; offset < rad.size(); offset += detail::normalize_block_size) {
+            std::size_t n = std::min(detail::normalize_block_size, rad.size() - offset);
+            detail::normalize_block(rad.data() + offset, tmp, n);
+            contains_block(tmp, mask.data() + offset, n);
+        }
+    }
+    std::size_t contains_indices(std::span<const T> rad, std::span<std::size_t> indices) const {
+        if (indices.size() < rad.size()) { throw std::invalid_argument("Index output is too small"); }
+        T tmp[detail::normalize_block_size];
+        uint8_t mask[detail::normalize_block_size];
+        std::size_t count = 0;
+        for (std::size_t offset = 0; offset < rad.size(); offset += detail::normalize_block_size) {
+            std::size_t n = std::min(detail::normalize_block_size, rad.size() - offset);
+            detail::normalize_block(rad.data() + offset, tmp, n);
+            contains_block(tmp, mask, n);
+            for (std::size_t i = 0; i < n; ++i) {
+                indices[count] = offset + i;
+                count += mask[i];
+            }
+        }
+        return count;
+    }
+    Pieces operator+(const AngleRange& other) const {
+        return combine(other, [](bool a, bool b) { return a || b; });
+    }
+    Pieces operator-(const AngleRange& other) const {
+        return combine(other, [](bool a, bool b) { return a && !b; });
+    }
+    Pieces intersect(const AngleRange& other) const {
+        return combine(other, [](bool a, bool b) { return a && b; });
+    }
+    Pieces operator&(const AngleRange& other) const { return intersect(other); }
+    static constexpr std::size_t max_str_size = 2 * Angle::max_str_size + 4;
+    static constexpr std::size_t max_repr_size = 2 * Angle::max_repr_size + 28;
+    std::to_chars_result to_chars(char* first, char* last) const {
+        std::to_chars_result result = detail::write_text(first, last, m_in_start ? "[" : "(");
+        if (result.ec == std::errc()) { result = m_start.to_chars(result.ptr, last); }
+        if (result.ec == std::errc()) { result = detail::write_text(result.ptr, last, "; "); }
+        if (result.ec == std::errc()) { result = m_end.to_chars(result.ptr, last); }
+        if (result.ec == std::errc()) { result = detail::write_text(result.ptr, last, m_in_end ? "]" : ")"); }
+        return result;
+    }
+    std::to_chars_result repr_to_chars(char* first, char* last) const {
+        std::to_chars_result result = detail::write_text(first, last, "AngleRange(");
+        if (result.ec == std::errc()) { result = m_start.repr_to_chars(result.ptr, last); }
+        if (result.ec == std::errc()) { result = detail::write_text(result.ptr, last, ", "); }
+        if (result.ec == std::errc()) { result = m_end.repr_to_chars(result.ptr, last); }
+        if (result.ec == std::errc()) { result = detail::write_text(result.ptr, last, m_in_start ? ", true" : ", false"); }
+        if (result.ec == std::errc()) { result = detail::write_text(result.ptr, last, m_in_end ? ", true)" : ", false)"); }
+        return result;
+    }
+    // Разбор "[30 deg; 60 deg)" и "AngleRange(Angle(..), Angle(..), true, false)";
+    // концы принимаются в любом виде, который понимает BasicAngle::parse.
+    static std::from_chars_result parse(const char* first, const char* last, AngleRange& out) {
+        const char* ptr = first;
+        Angle start, end;
+        bool in_start, in_end;
+        auto angle = [&](Angle& value) {
+            std::from_chars_result result = Angle::parse(detail::skip_spaces(ptr, last), last, value);
+            ptr = detail::skip_spaces(result.ptr, last);
+            return result.ec == std::errc();
+        };
+        auto token = [&](std::string_view text) {
+            ptr = detail::skip_spaces(ptr, last);
+            return detail::consume(ptr, last, text);
+        };
+        auto flag = [&](bool& value) {
+            ptr = detail::skip_spaces(ptr, last);
+            return detail::consume_bool(ptr, last, value);
+        };
+        bool ok;
+        if (detail::consume(ptr, last, "AngleRange(")) {
+            ok = angle(start) && token(",") && angle(end) && token(",") && flag(in_start)
+                && token(",") && flag(in_end) && token(")");
+        }
+        else {
+            in_start = detail::consume(ptr, last, "[");
+            ok = (in_start || detail::consume(ptr, last, "(")) && angle(start) && token(";") && angle(end);
+            in_end = ok && detail::consume(ptr, last, "]");
+            ok = ok && (in_end || detail::consume(ptr, last, ")"));
+        }
+        if (!ok) { return {first, std::errc::invalid_argument}; }
+        out = AngleRange(start, end, in_start, in_end);
+        return {ptr, std::errc()};
+    }
+    static std::from_chars_result parse(std::string_view text, AngleRange& out) {
+        return parse(text.data(), text.data() + text.size(), out);
+    }
+    std::string str() const {
+        char buffer[max_str_size];
+        return std::string(buffer, to_chars(buffer, buffer + max_str_size).ptr);
+    }
+    std::string repr() const {
+        char buffer[max_repr_size];
+        return std::string(buffer, repr_to_chars(buffer, buffer + max_repr_size).ptr);
+    }
+    friend std::ostream& operator<<(std::ostream& os, const AngleRange& range) {
+        char buffer[max_str_size];
+        return os.write(buffer, range.to_chars(buffer, buffer + max_str_size).ptr - buffer);
+    }
+};
+
+using AngleRange = BasicAngleRange<float>;
+static_assert(std::is_trivially_copyable_v<AngleRange> && std::is_standard_layout_v<AngleRange>);
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef ANGLE_BUFFER_H
+#define ANGLE_BUFFER_H
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "angle.h"
+
+
+// Углы в радианах, лежащие подряд в памяти. Пакетные операции написаны
+// простыми циклами без ветвлений, чтобы компилятор их векторизовал, и дают
+// те же значения, что и методы BasicAngle для каждого элемента.
+template <typename T>
+class BasicAngleBuffer {
+    using Angle = BasicAngle<T>;
+    using calc_type = typename Angle::calc_type;
+    static constexpr std::size_t block = detail::normalize_block_size;
+    std::vector<T> m_rad;
+
+    template <typename Compare>
+    void compare(const Angle& other, std::span<uint8_t> mask, Compare cmp) const {
+        if (mask.size() < m_rad.size()) { throw std::invalid_argument("Mask is too small"); }
+        T rhs = Angle::normalize(other.getRadians());
+        T tmp[block];
+        for (std::size_t offset = 0; offset < m_rad.size(); offset += block) {
+            std::size_t n = std::min(block, m_rad.size() - offset);
+            detail::normalize_block(m_rad.data() + offset, tmp, n);
+            uint8_t* out = mask.data() + offset;
+            for (std::size_t i = 0; i < n; ++i) { out[i] = cmp(tmp[i], rhs); }
+        }
+    }
+public:
+    using value_type = T;
+    BasicAngleBuffer() {}
+    explicit BasicAngleBuffer(std::size_t size): m_rad(size) {}
+    explicit BasicAngleBuffer(std::span<const T> rad): m_rad(rad.begin(), rad.end()) {}
+    explicit BasicAngleBuffer(std::span<const Angle> angles): m_rad(angles.size()) {
+        for (std::size_t i = 0; i < angles.size(); ++i) { m_rad[i] = angles[i].getRadians(); }
+    }
+    static BasicAngleBuffer from_radians(std::span<const T> rad) { return BasicAngleBuffer(rad); }
+    static BasicAngleBuffer from_degrees(std::span<const T> deg) {
+        BasicAngleBuffer result(deg.size());
+        T* out = result.m_rad.data();
+        for (std::size_t i = 0; i < deg.size(); ++i) { out[i] = deg[i] * Angle::pi / 180; }
+        return result;
+    }
+    std::size_t size() const { return m_rad.size(); }
+    bool empty() const { return m_rad.empty(); }
+    void reserve(std::size_t size) { m_rad.reserve(size); }
+    void resize(std::size_t size) { m_rad.resize(size); }
+    void clear() { m_rad.clear(); }
+    void push_back(const Angle& angle) { m_rad.push_back(angle.getRadians()); }
+    T* data() { return m_rad.data(); }
+    const T* data() const { return m_rad.data(); }
+    std::span<T> radians() { return m_rad; }
+    std::span<const T> radians() const { return m_rad; }
+    Angle operator[](std::size_t i) const { return Angle(m_rad[i]); }
+    BasicAngleBuffer& set(std::size_t i, const Angle& angle) {
+        m_rad[i] = angle.getRadians();
+        return *this;
+    }
+    BasicAngleBuffer& add(const Angle& other) {
+        T rad = other.getRadians();
+        T* x = m_rad.data();
+        for (std::size_t i = 0; i < m_rad.size(); ++i) { x[i] = x[i] + rad; }
+        return *this;
+    }
+    BasicAngleBuffer& add(const BasicAngleBuffer& other) {
+        if (other.size() != size()) { throw std::invalid_argument("Buffer sizes differ"); }
+        T* x = m_rad.data();
+        const T* y = other.m_rad.data();
+        for (std::size_t i = 0; i < m_rad.size(); ++i) { x[i] = x[i] + y[i]; }
+        return *this;
+    }
+    BasicAngleBuffer& scale(T factor) {
+        T* x = m_rad.data();
+        for (std::size_t i = 0; i < m_rad.size(); ++i) { x[i] = x[i] * factor; }
+        return *this;
+    }
+    BasicAngleBuffer& normalize() {
+        for (std::size_t offset = 0; offset < m_rad.size(); offset += block) {
+            std::size_t n = std::min(block, m_rad.size() - offset);
+            detail::normalize_block(m_rad.data() + offset, m_rad.data() + offset, n);
+        }
+        return *this;
+    }
+    void to_degrees(std::span<int> out) const {
+        if (out.size() < m_rad.size()) { throw std::invalid_argument("Output is too small"); }
+        const T* x = m_rad.data();
+        for (std::size_t i = 0; i < m_rad.size(); ++i) {
+            calc_type deg = x[i] * calc_type(180) / Angle::pi;
+            int whole = deg;
+            calc_type frac = deg - whole;
+            out[i] = whole + (frac >= calc_type(0.5)) - (frac <= calc_type(-0.5));
+        }
+    }
+    void less(const Angle& other, std::span<uint8_t> mask) const {
+        compare(other, mask, [](T a, T b) { return a < b; });
+    }
+    void less_equal(const Angle& other, std::span<uint8_t> mask) const {
+        compare(other, mask, [](T a, T b) { return !(a > b); });
+    }
+    void greater(const Angle& other, std::span<uint8_t> mask) const {
+        compare(other, mask, [](T a, T b) { return a > b; });
+    }
+    void greater_equal(const Angle& other, std::span<uint8_t> mask) const {
+        compare(other, mask, [](T a, T b) { return !(a < b); });
+    }
+    void equal(const Angle& other, std::span<uint8_t> mask) const {
+        compare(other, mask, [](T a, T b) { return a - b < T(1e-6) && b - a < T(1e-6); });
+    }
+};
+
+using AngleBuffer = BasicAngleBuffer<float>;
+
+#endif
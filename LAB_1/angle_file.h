@@ -0,0 +1,192 @@
+#ifndef ANGLE_FILE_H
+#define ANGLE_FILE_H
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "angle.h"
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ANGLE_FILE_MMAP 1
+#endif
+
+
+// Двоичный файл с последовательностью углов или дуг (little-endian):
+//   0   char[4]  "ANGL"
+//   4   uint16   версия формата
+//   6   uint8    содержимое: 1 - углы, 2 - дуги
+//   7   uint8    sizeof значения: 4 - float, 8 - double
+//   8   uint64   количество записей
+//   16  ...      нули до header_size
+// Углы лежат подряд в радианах. Дуги хранятся столбцами: все start, все end
+// (сырые радианы, без приведения к [0, 2pi) - от них зависит is_full), затем
+// по байту флагов на дугу: бит 0 - includesStart, бит 1 - includesEnd.
+namespace detail {
+    // Файл целиком в памяти: mmap, где он есть, иначе обычное чтение.
+    class MappedFile {
+        const std::byte* m_data = nullptr;
+        std::size_t m_size = 0;
+        std::vector<std::byte> m_copy;
+    public:
+        explicit MappedFile(const std::string& path) {
+#ifdef ANGLE_FILE_MMAP
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) { throw std::runtime_error("Cannot open " + path); }
+            struct stat info;
+            if (::fstat(fd, &info) != 0) {
+                ::close(fd);
+                throw std::runtime_error("Cannot stat " + path);
+            }
+            m_size = info.st_size;
+            if (m_size > 0) {
+                void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                ::close(fd);
+                if (data == MAP_FAILED) { throw std::runtime_error("Cannot map " + path); }
+                m_data = static_cast<const std::byte*>(data);
+                return;
+            }
+            ::close(fd);
+#else
+            std::ifstream file(path, std::ios::binary | std::ios::ate);
+            if (!file) { throw std::runtime_error("Cannot open " + path); }
+            m_copy.resize(static_cast<std::size_t>(file.tellg()));
+            file.seekg(0);
+            file.read(reinterpret_cast<char*>(m_copy.data()), m_copy.size());
+            if (!file) { throw std::runtime_error("Cannot read " + path); }
+            m_data = m_copy.data();
+            m_size = m_copy.size();
+#endif
+        }
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        ~MappedFile() {
+#ifdef ANGLE_FILE_MMAP
+            if (m_data) { ::munmap(const_cast<std::byte*>(m_data), m_size); }
+#endif
+        }
+        const std::byte* data() const { return m_data; }
+        std::size_t size() const { return m_size; }
+    };
+}
+
+// Открытый файл углов или дуг. Данные не копируются: radians(), starts() и
+// ends() смотрят прямо в отображённую память и годятся для пакетных
+// AngleRange::contains и BasicAngleBuffer.
+template <typename T>
+class BasicAngleFile {
+    using Angle = BasicAngle<T>;
+    using AngleRange = BasicAngleRange<T>;
+    detail::MappedFile m_file;
+    uint8_t m_kind = 0;
+    std::size_t m_count = 0;
+
+    struct Header {
+        char magic[4];
+        uint16_t version;
+        uint8_t kind;
+        uint8_t value_size;
+        uint64_t count;
+    };
+    static void check_byte_order() {
+        if constexpr (std::endian::native != std::endian::little) {
+            throw std::runtime_error("Angle files are little-endian only");
+        }
+    }
+    static void write(const std::string& path, uint8_t kind, std::size_t count, std::span<const std::span<const std::byte>> columns) {
+        check_byte_order();
+        Header header{{'A', 'N', 'G', 'L'}, version, kind, sizeof(T), count};
+        char bytes[header_size] = {};
+        std::memcpy(bytes, &header, sizeof(header));
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(bytes, header_size);
+        for (std::span<const std::byte> column : columns) {
+            file.write(reinterpret_cast<const char*>(column.data()), column.size());
+        }
+        if (!file) { throw std::runtime_error("Cannot write " + path); }
+    }
+    const T* column(std::size_t index) const {
+        return reinterpret_cast<const T*>(m_file.data() + header_size) + index * m_count;
+    }
+    void expect(uint8_t kind) const {
+        if (m_kind != kind) { throw std::invalid_argument(kind == angles ? "File holds ranges" : "File holds angles"); }
+    }
+public:
+    using value_type = T;
+    static constexpr uint16_t version = 1;
+    static constexpr uint8_t angles = 1;
+    static constexpr uint8_t ranges = 2;
+    // Кратно 32, чтобы данные после заголовка были выровнены под SIMD.
+    static constexpr std::size_t header_size = 32;
+
+    explicit BasicAngleFile(const std::string& path): m_file(path) {
+        check_byte_order();
+        Header header;
+        if (m_file.size() < header_size) { throw std::invalid_argument("Not an angle file: " + path); }
+        std::memcpy(&header, m_file.data(), sizeof(header));
+        if (std::memcmp(header.magic, "ANGL", 4) != 0) { throw std::invalid_argument("Not an angle file: " + path); }
+        if (header.version > version) { throw std::invalid_argument("Unsupported angle file version"); }
+        if (header.value_size != sizeof(T)) { throw std::invalid_argument("Angle file has another value type"); }
+        if (header.kind != angles && header.kind != ranges) { throw std::invalid_argument("Unknown angle file content"); }
+        std::size_t record = header.kind == angles ? sizeof(T) : 2 * sizeof(T) + 1;
+        if (header.count > (m_file.size() - header_size) / record) { throw std::invalid_argument("Angle file is truncated"); }
+        m_kind = header.kind;
+        m_count = header.count;
+    }
+    static void write(const std::string& path, std::span<const T> rad) {
+        std::span<const std::byte> columns[] = {std::as_bytes(rad)};
+        write(path, angles, rad.size(), columns);
+    }
+    static void write(const std::string& path, std::span<const Angle> values) {
+        std::span<const std::byte> columns[] = {Angle::to_bytes(values)};
+        write(path, angles, values.size(), columns);
+    }
+    static void write(const std::string& path, std::span<const AngleRange> values) {
+        std::vector<T> starts(values.size()), ends(values.size());
+        std::vector<uint8_t> flags(values.size());
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            starts[i] = values[i].getStart().getRadians();
+            ends[i] = values[i].getEnd().getRadians();
+            flags[i] = values[i].includesStart() | values[i].includesEnd() << 1;
+        }
+        std::span<const std::byte> columns[] = {
+            std::as_bytes(std::span<const T>(starts)),
+            std::as_bytes(std::span<const T>(ends)),
+            std::as_bytes(std::span<const uint8_t>(flags)),
+        };
+        write(path, ranges, values.size(), columns);
+    }
+    bool holds_ranges() const { return m_kind == ranges; }
+    std::size_t size() const { return m_count; }
+    std::span<const T> radians() const {
+        expect(angles);
+        return {column(0), m_count};
+    }
+    std::span<const T> starts() const {
+        expect(ranges);
+        return {column(0), m_count};
+    }
+    std::span<const T> ends() const {
+        expect(ranges);
+        return {column(1), m_count};
+    }
+    std::span<const uint8_t> flags() const {
+        expect(ranges);
+        return {reinterpret_cast<const uint8_t*>(column(2)), m_count};
+    }
+    Angle angle(std::size_t i) const { return Angle(radians()[i]); }
+    AngleRange range(std::size_t i) const {
+        uint8_t flag = flags()[i];
+        return AngleRange(Angle(starts()[i]), Angle(ends()[i]), flag & 1, flag & 2);
+    }
+};
+
+using AngleFile = BasicAngleFile<float>;
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef ANGLE_RANGE_INDEX_H
+#define ANGLE_RANGE_INDEX_H
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "angle.h"
+
+
+// Индекс для запросов "какие дуги содержат угол" за O(log n + k) вместо
+// обхода всех дуг. Каждая дуга разбивается на полуинтервалы границ, как в
+// AngleRangeSet, так что включённость концов учитывается сама, а куски одной
+// дуги не пересекаются и не дают повторов. Полуинтервалы лежат в
+// центрированном дереве интервалов: в узле - куски, содержащие его центр,
+// отсортированные по началу и по концу, слева - лежащие целиком до центра,
+// справа - после. Дерево хранится плоскими массивами и не меняется после
+// построения.
+template <typename T>
+class BasicAngleRangeIndex {
+    using Angle = BasicAngle<T>;
+    using AngleRange = BasicAngleRange<T>;
+    using Bound = detail::ArcBound<T>;
+    using Interval = detail::ArcInterval<T>;
+    static constexpr std::size_t block = detail::normalize_block_size;
+
+    struct Entry {
+        Bound bound;
+        uint32_t id;
+    };
+    struct Node {
+        T center;
+        uint32_t first;
+        uint32_t count;
+        int32_t left;
+        int32_t right;
+    };
+    struct Item {
+        Interval part;
+        uint32_t id;
+        T point;
+    };
+    std::vector<Node> m_nodes;
+    std::vector<Entry> m_by_lo;
+    std::vector<Entry> m_by_hi;
+    std::size_t m_size = 0;
+
+    // Центр узла - медиана первых точек кусков, и кусок-медиана сам содержит
+    // центр, так что каждый узел забирает хотя бы один кусок.
+    int32_t build(Item* first, Item* last) {
+        if (first == last) { return -1; }
+        Item* middle = first + (last - first) / 2;
+        std::nth_element(first, middle, last, [](const Item& a, const Item& b) { return a.point < b.point; });
+        T center = middle->point;
+        Bound before{center, false}, after{center, true};
+        Item* here = std::partition(first, last, [&](const Item& item) { return item.part.hi <= before; });
+        Item* right = std::partition(here, last, [&](const Item& item) { return !(after <= item.part.lo); });
+        int32_t index = static_cast<int32_t>(m_nodes.size());
+        m_nodes.push_back(Node{center, static_cast<uint32_t>(m_by_lo.size()), static_cast<uint32_t>(right - here), -1, -1});
+        std::sort(here, right, [](const Item& a, const Item& b) { return a.part.lo < b.part.lo; });
+        for (Item* item = here; item != right; ++item) { m_by_lo.push_back(Entry{item->part.lo, item->id}); }
+        std::sort(here, right, [](const Item& a, const Item& b) { return b.part.hi < a.part.hi; });
+        for (Item* item = here; item != right; ++item) { m_by_hi.push_back(Entry{item->part.hi, item->id}); }
+        int32_t left_child = build(first, here);
+        int32_t right_child = build(right, last);
+        m_nodes[index].left = left_child;
+        m_nodes[index].right = right_child;
+        return index;
+    }
+    // Угол уже приведён к [0, 2pi). Спуск идёт по одной ветви; в узле
+    // просматриваются только куски, которые точно содержат угол, плюс один.
+    template <typename F>
+    void visit(T rad, F f) const {
+        Bound before{rad, false}, after{rad, true};
+        int32_t index = m_nodes.empty() ? -1 : 0;
+        while (index >= 0) {
+            const Node& node = m_nodes[index];
+            if (rad < node.center) {
+                const Entry* entry = m_by_lo.data() + node.first;
+                for (uint32_t i = 0; i < node.count && entry[i].bound <= before; ++i) { f(entry[i].id); }
+                index = node.left;
+            }
+            else if (rad > node.center) {
+                const Entry* entry = m_by_hi.data() + node.first;
+                for (uint32_t i = 0; i < node.count && after <= entry[i].bound; ++i) { f(entry[i].id); }
+                index = node.right;
+            }
+            else {
+                if (rad == node.center) {
+                    for (uint32_t i = 0; i < node.count; ++i) { f(m_by_lo[node.first + i].id); }
+                }
+                return;
+            }
+        }
+    }
+public:
+    using value_type = T;
+    BasicAngleRangeIndex() {}
+    explicit BasicAngleRangeIndex(std::span<const AngleRange> ranges): m_size(ranges.size()) {
+        if (ranges.size() > std::numeric_limits<uint32_t>::max()) { throw std::invalid_argument("Too many ranges for an index"); }
+        std::vector<Item> items;
+        items.reserve(2 * ranges.size());
+        for (std::size_t i = 0; i < ranges.size(); ++i) {
+            Interval parts[2];
+            std::size_t count = ranges[i].to_intervals(parts);
+            for (std::size_t j = 0; j < count; ++j) {
+                Item item{parts[j], static_cast<uint32_t>(i), 0};
+                // Кусок без единого угла в индекс не попадает.
+                if (detail::first_angle(item.part, item.point)) { items.push_back(item); }
+            }
+        }
+        m_nodes.reserve(items.size());
+        m_by_lo.reserve(items.size());
+        m_by_hi.reserve(items.size());
+        build(items.data(), items.data() + items.size());
+    }
+    // Число дуг, по которым построен индекс; номера дуг в ответах - их позиции.
+    std::size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    // f(номер) для каждой дуги, содержащей угол, в произвольном порядке.
+    template <typename F>
+    void for_each(const Angle& angle, F f) const { visit(Angle::normalize(angle.getRadians()), f); }
+    std::size_t count(const Angle& angle) const {
+        std::size_t result = 0;
+        for_each(angle, [&](uint32_t) { ++result; });
+        return result;
+    }
+    // Номера дуг, содержащих угол, дописываются в конец out; возвращается их число.
+    std::size_t query(const Angle& angle, std::vector<std::size_t>& out) const {
+        std::size_t before = out.size();
+        for_each(angle, [&](uint32_t id) { out.push_back(id); });
+        return out.size() - before;
+    }
+    // Пакетный запрос: ответ для rad[i] - ids[offsets[i]] .. ids[offsets[i + 1]].
+    void query(std::span<const T> rad, std::vector<std::size_t>& offsets, std::vector<std::size_t>& ids) const {
+        offsets.resize(rad.size() + 1);
+        offsets[0] = 0;
+        ids.clear();
+        T tmp[block];
+        for (std::size_t offset = 0; offset < rad.size(); offset += block) {
+            std::size_t n = std::min(block, rad.size() - offset);
+            detail::normalize_block(rad.data() + offset, tmp, n);
+            for (std::size_t i = 0; i < n; ++i) {
+                visit(tmp[i], [&](uint32_t id) { ids.push_back(id); });
+                offsets[offset + i + 1] = ids.size();
+            }
+        }
+    }
+};
+
+using AngleRangeIndex = BasicAngleRangeIndex<float>;
+
+#endif
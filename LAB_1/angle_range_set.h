@@ -0,0 +1,204 @@
+#ifndef ANGLE_RANGE_SET_H
+#define ANGLE_RANGE_SET_H
+#include <algorithm>
+#include <span>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "angle.h"
+
+
+// Множество точек окружности, хранящееся как упорядоченный список
+// непересекающихся и не касающихся полуинтервалов внутри [0, 2pi).
+// Операции над множествами пишут результат во внутренний буфер и меняют его
+// местами с основным, так что после разогрева память не выделяется.
+template <typename T>
+class BasicAngleRangeSet {
+    using Angle = BasicAngle<T>;
+    using AngleRange = BasicAngleRange<T>;
+    using Bound = detail::ArcBound<T>;
+    using Interval = detail::ArcInterval<T>;
+    std::vector<Interval> m_parts;
+    std::vector<Interval> m_scratch;
+
+    template <typename Op>
+    BasicAngleRangeSet& combine(const Interval* other, std::size_t count, Op op) {
+        m_scratch.clear();
+        detail::combine_intervals(m_parts.data(), m_parts.size(), other, count, op, m_scratch);
+        m_parts.swap(m_scratch);
+        return *this;
+    }
+    template <typename Op>
+    BasicAngleRangeSet& combine(const AngleRange& range, Op op) {
+        Interval pieces[2];
+        std::size_t count = range.to_intervals(pieces);
+        return combine(pieces, count, op);
+    }
+    static bool both(bool a, bool b) { return a && b; }
+    static bool either(bool a, bool b) { return a || b; }
+    static bool only_first(bool a, bool b) { return a && !b; }
+    static bool only_second(bool a, bool b) { return !a && b; }
+    // Индекс куска, который может содержать границу: последний с lo <= bound.
+    std::size_t locate(const Bound& bound) const {
+        auto it = std::upper_bound(m_parts.begin(), m_parts.end(), bound,
+            [](const Bound& value, const Interval& part) { return value < part.lo; });
+        return it - m_parts.begin();
+    }
+    bool covers(const Interval& piece) const {
+        std::size_t i = locate(piece.lo);
+        return i > 0 && piece.hi <= m_parts[i - 1].hi;
+    }
+    // Вставка одного полуинтервала: касающиеся и пересекающиеся куски сливаются на месте.
+    void insert(const Interval& piece) {
+        auto first = std::lower_bound(m_parts.begin(), m_parts.end(), piece.lo,
+            [](const Interval& part, const Bound& value) { return part.hi < value; });
+        auto last = std::upper_bound(first, m_parts.end(), piece.hi,
+            [](const Bound& value, const Interval& part) { return value < part.lo; });
+        if (first == last) {
+            m_parts.insert(first, piece);
+            return;
+        }
+        first->lo = std::min(first->lo, piece.lo);
+        first->hi = std::max((last - 1)->hi, piece.hi);
+        m_parts.erase(first + 1, last);
+    }
+    // Произвольный набор полуинтервалов в m_parts: сортировка по началу и
+    // слияние пересекающихся и касающихся кусков на месте за один проход.
+    void coalesce() {
+        std::sort(m_parts.begin(), m_parts.end(), [](const Interval& a, const Interval& b) { return a.lo < b.lo; });
+        std::size_t size = 0;
+        for (const Interval& part : m_parts) {
+            if (size > 0 && part.lo <= m_parts[size - 1].hi) { m_parts[size - 1].hi = std::max(m_parts[size - 1].hi, part.hi); }
+            else { m_parts[size++] = part; }
+        }
+        m_parts.resize(size);
+    }
+public:
+    using value_type = T;
+    using calc_type = typename Angle::calc_type;
+    BasicAngleRangeSet() {}
+    BasicAngleRangeSet(const AngleRange& range) { unite(range); }
+    explicit BasicAngleRangeSet(std::span<const AngleRange> ranges) { *this = union_all(ranges); }
+    // Объединение многих дуг за O(n log n) вместо вставки по одной: куски
+    // всех дуг сортируются один раз и сливаются одним проходом. Память -
+    // один вектор на 2n кусков.
+    static BasicAngleRangeSet union_all(std::span<const AngleRange> ranges) {
+        BasicAngleRangeSet result;
+        result.m_parts.reserve(2 * ranges.size());
+        for (const AngleRange& range : ranges) {
+            Interval pieces[2];
+            std::size_t count = range.to_intervals(pieces);
+            result.m_parts.insert(result.m_parts.end(), pieces, pieces + count);
+        }
+        result.coalesce();
+        return result;
+    }
+    // То же по частям массива в нескольких потоках (threads = 0 - по числу
+    // ядер) со слиянием частичных объединений по порядку. Частей не больше,
+    // чем по min_chunk дуг на каждую.
+    static constexpr std::size_t min_chunk = 1 << 12;
+    static BasicAngleRangeSet union_all(std::span<const AngleRange> ranges, unsigned threads) {
+        if (threads == 0) { threads = std::max(1u, std::thread::hardware_concurrency()); }
+        std::size_t workers = std::min<std::size_t>(threads, std::max<std::size_t>(1, ranges.size() / min_chunk));
+        if (workers <= 1) { return union_all(ranges); }
+        std::vector<BasicAngleRangeSet> partial(workers);
+        auto work = [&](std::size_t i) {
+            std::size_t first = ranges.size() * i / workers, last = ranges.size() * (i + 1) / workers;
+            partial[i] = union_all(ranges.subspan(first, last - first));
+        };
+        std::vector<std::thread> pool;
+        pool.reserve(workers - 1);
+        for (std::size_t i = 1; i < workers; ++i) { pool.emplace_back(work, i); }
+        work(0);
+        for (std::thread& thread : pool) { thread.join(); }
+        for (std::size_t i = 1; i < workers; ++i) { partial[0].unite(partial[i]); }
+        return std::move(partial[0]);
+    }
+    static BasicAngleRangeSet full() { return BasicAngleRangeSet(AngleRange::full()); }
+    bool empty() const { return m_parts.empty(); }
+    bool is_full() const { return m_parts.size() == 1 && m_parts[0] == Interval::circle(); }
+    void clear() { m_parts.clear(); }
+    void reserve(std::size_t size) { m_parts.reserve(size); }
+    std::span<const Interval> intervals() const { return m_parts; }
+    std::vector<AngleRange> ranges() const {
+        std::vector<AngleRange> result;
+        result.reserve(m_parts.size());
+        AngleRange::from_intervals(m_parts.data(), m_parts.size(), result);
+        return result;
+    }
+    calc_type length() const {
+        calc_type total = 0;
+        for (const Interval& part : m_parts) {
+            calc_type hi = part.hi == Bound::end() ? 2 * Angle::pi : calc_type(part.hi.rad);
+            total += hi - part.lo.rad;
+        }
+        return total;
+    }
+    bool contains(const Angle& angle) const {
+        T rad = Angle::normalize(angle.getRadians());
+        if (rad != rad) { return false; }
+        std::size_t i = locate(Bound{rad, false});
+        return i > 0 && Bound{rad, false} < m_parts[i - 1].hi;
+    }
+    bool contains(const AngleRange& range) const {
+        Interval pieces[2];
+        std::size_t count = range.to_intervals(pieces);
+        for (std::size_t i = 0; i < count; ++i) {
+            if (!covers(pieces[i])) { return false; }
+        }
+        return true;
+    }
+    BasicAngleRangeSet& unite(const AngleRange& range) {
+        Interval pieces[2];
+        std::size_t count = range.to_intervals(pieces);
+        for (std::size_t i = 0; i < count; ++i) { insert(pieces[i]); }
+        return *this;
+    }
+    BasicAngleRangeSet& unite(const BasicAngleRangeSet& other) {
+        return combine(other.m_parts.data(), other.m_parts.size(), either);
+    }
+    BasicAngleRangeSet& intersect(const AngleRange& range) { return combine(range, both); }
+    BasicAngleRangeSet& intersect(const BasicAngleRangeSet& other) {
+        return combine(other.m_parts.data(), other.m_parts.size(), both);
+    }
+    BasicAngleRangeSet& subtract(const AngleRange& range) { return combine(range, only_first); }
+    BasicAngleRangeSet& subtract(const BasicAngleRangeSet& other) {
+        return combine(other.m_parts.data(), other.m_parts.size(), only_first);
+    }
+    BasicAngleRangeSet& complement() {
+        Interval circle = Interval::circle();
+        return combine(&circle, 1, only_second);
+    }
+    BasicAngleRangeSet& operator+=(const AngleRange& range) { return unite(range); }
+    BasicAngleRangeSet& operator+=(const BasicAngleRangeSet& other) { return unite(other); }
+    BasicAngleRangeSet& operator-=(const AngleRange& range) { return subtract(range); }
+    BasicAngleRangeSet& operator-=(const BasicAngleRangeSet& other) { return subtract(other); }
+    BasicAngleRangeSet& operator&=(const AngleRange& range) { return intersect(range); }
+    BasicAngleRangeSet& operator&=(const BasicAngleRangeSet& other) { return intersect(other); }
+    bool operator==(const BasicAngleRangeSet& other) const { return m_parts == other.m_parts; }
+    bool operator!=(const BasicAngleRangeSet& other) const { return !(*this == other); }
+    std::string str() const {
+        std::vector<AngleRange> parts = ranges();
+        if (parts.empty()) { return "{}"; }
+        std::string result;
+        for (std::size_t i = 0; i < parts.size(); ++i) {
+            if (i > 0) { result += " U "; }
+            result += parts[i].str();
+        }
+        return result;
+    }
+    std::string repr() const {
+        std::vector<AngleRange> parts = ranges();
+        std::string result = "AngleRangeSet(";
+        for (std::size_t i = 0; i < parts.size(); ++i) {
+            if (i > 0) { result += ", "; }
+            result += parts[i].repr();
+        }
+        return result + ")";
+    }
+};
+
+using AngleRangeSet = BasicAngleRangeSet<float>;
+
+#endif
@@ -0,0 +1,356 @@
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "angle.h"
+#include "angle_range_set.h"
+
+
+// Потоковая обработка CSV/TSV с углами:
+//   ./angle_tool <команда> [опции] [файл]
+// Команды:
+//   normalize       привести угол в столбце к [0, 2pi)
+//   convert         перевести угол в столбце в единицы --out
+//   filter <дуга>   оставить строки, угол которых лежит в дуге, например "[350 deg; 10 deg]"
+//   union           объединить дуги и вывести их как start,end,includes_start,includes_end
+// Опции:
+//   --column N      номер столбца с углом, с единицы (1)
+//   --delimiter C   разделитель полей (,); --tsv - то же, что --delimiter '\t'
+//   --in deg|rad    единицы чисел без суффикса (rad)
+//   --out deg|rad   единицы вывода (rad)
+//   --header        первая строка - заголовок
+// Угол в поле - число или текст, понятный Angle::parse. Дуга для union - текст,
+// понятный AngleRange::parse, или два числа в столбцах N и N+1 (концы включены).
+// Без файла читается stdin, результат пишется в stdout.
+
+struct Options {
+    std::string command;
+    std::string range;
+    std::size_t column = 0;
+    char delimiter = ',';
+    bool in_degrees = false;
+    bool out_degrees = false;
+    bool header = false;
+    const char* input = nullptr;
+};
+
+// Построчное чтение большими блоками; строка действительна до следующего вызова next.
+class LineReader {
+    std::FILE* m_file;
+    std::vector<char> m_buffer;
+    std::size_t m_begin = 0;
+    std::size_t m_end = 0;
+    bool m_eof = false;
+public:
+    explicit LineReader(std::FILE* file, std::size_t size = 1 << 20): m_file(file), m_buffer(size) {}
+    bool next(std::string_view& line) {
+        while (true) {
+            const char* begin = m_buffer.data() + m_begin;
+            const char* newline = static_cast<const char*>(std::memchr(begin, '\n', m_end - m_begin));
+            if (newline || (m_eof && m_begin != m_end)) {
+                const char* end = newline ? newline : m_buffer.data() + m_end;
+                m_begin = newline ? newline - m_buffer.data() + 1 : m_end;
+                if (end != begin && end[-1] == '\r') { --end; }
+                line = std::string_view(begin, end - begin);
+                return true;
+            }
+            if (m_eof) { return false; }
+            std::memmove(m_buffer.data(), begin, m_end - m_begin);
+            m_end -= m_begin;
+            m_begin = 0;
+            if (m_end == m_buffer.size()) { m_buffer.resize(2 * m_buffer.size()); }
+            std::size_t count = std::fread(m_buffer.data() + m_end, 1, m_buffer.size() - m_end, m_file);
+            if (count == 0 && std::ferror(m_file)) { throw std::runtime_error("Read error"); }
+            m_end += count;
+            m_eof = count == 0;
+        }
+    }
+};
+
+// Буфер вывода: числа пишутся через to_chars прямо в него, на диск - большими кусками.
+class Writer {
+    std::FILE* m_file;
+    std::vector<char> m_buffer;
+    std::size_t m_size = 0;
+    static constexpr std::size_t max_number_size = 64;
+
+    char* reserve(std::size_t size) {
+        if (m_buffer.size() - m_size < size) {
+            flush();
+            if (m_buffer.size() < size) { m_buffer.resize(size); }
+        }
+        return m_buffer.data() + m_size;
+    }
+public:
+    // Недописанный буфер при ошибке отбрасывается: на диск попадает только
+    // то, что записал flush.
+    explicit Writer(std::FILE* file, std::size_t size = 1 << 20): m_file(file), m_buffer(size) {}
+    void write(std::string_view text) {
+        std::memcpy(reserve(text.size()), text.data(), text.size());
+        m_size += text.size();
+    }
+    void put(char c) { *reserve(1) = c; ++m_size; }
+    template <typename T>
+    void number(T value) {
+        char* first = reserve(max_number_size);
+        m_size = std::to_chars(first, first + max_number_size, value).ptr - m_buffer.data();
+    }
+    void flush() {
+        if (m_size && std::fwrite(m_buffer.data(), 1, m_size, m_file) != m_size) {
+            m_size = 0;
+            throw std::runtime_error("Write error");
+        }
+        m_size = 0;
+    }
+};
+
+// Положение поля column в строке; npos, если полей меньше.
+std::size_t find_field(std::string_view line, char delimiter, std::size_t column, std::size_t& size) {
+    std::size_t first = 0;
+    for (std::size_t i = 0; i < column; ++i) {
+        const void* next = std::memchr(line.data() + first, delimiter, line.size() - first);
+        if (!next) { return std::string_view::npos; }
+        first = static_cast<const char*>(next) - line.data() + 1;
+    }
+    const void* next = std::memchr(line.data() + first, delimiter, line.size() - first);
+    size = (next ? static_cast<const char*>(next) - line.data() : line.size()) - first;
+    return first;
+}
+
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && text.front() == ' ') { text.remove_prefix(1); }
+    while (!text.empty() && text.back() == ' ') { text.remove_suffix(1); }
+    return text;
+}
+
+bool parse_angle(std::string_view text, bool degrees, Angle& out) {
+    text = trim(text);
+    const char* last = text.data() + text.size();
+    float value;
+    std::from_chars_result number = detail::parse_number(text.data(), last, value);
+    if (number.ec == std::errc() && number.ptr == last) {
+        out = degrees ? Angle::from_degrees(value) : Angle::from_radians(value);
+        return true;
+    }
+    std::from_chars_result parsed = Angle::parse(text, out);
+    return parsed.ec == std::errc() && parsed.ptr == last;
+}
+
+// Угол в градусах в double: при --in deg --out deg число не проходит
+// через радианы float, и 370 превращается ровно в 10.
+bool parse_degrees(std::string_view text, bool degrees, double& out) {
+    text = trim(text);
+    const char* last = text.data() + text.size();
+    double value;
+    std::from_chars_result number = detail::parse_number(text.data(), last, value);
+    if (number.ec == std::errc() && number.ptr == last) {
+        out = degrees ? value : value * 180 / BasicAngle<double>::pi;
+        return true;
+    }
+    BasicAngle<double> angle;
+    std::from_chars_result parsed = BasicAngle<double>::parse(text, angle);
+    out = angle.getRadians() * 180 / BasicAngle<double>::pi;
+    return parsed.ec == std::errc() && parsed.ptr == last;
+}
+
+// Приведение к [0, 360); то, что при записи во float округлится до 360, - это 0.
+double normalize_degrees(double deg) {
+    deg = std::fmod(deg, 360.0);
+    if (deg < 0) { deg += 360; }
+    return static_cast<float>(deg) < 360 ? deg : 0;
+}
+
+class Tool {
+    Options m_options;
+    LineReader m_reader;
+    Writer m_writer;
+    std::size_t m_line = 0;
+
+    [[noreturn]] void fail(const char* message) const {
+        throw std::invalid_argument("line " + std::to_string(m_line) + ": " + message);
+    }
+    std::string_view field(std::string_view line, std::size_t column, std::size_t& first) const {
+        std::size_t size = 0;
+        first = find_field(line, m_options.delimiter, column, size);
+        if (first == std::string_view::npos) { fail("missing column"); }
+        return line.substr(first, size);
+    }
+    Angle angle(std::string_view line, std::size_t& first, std::size_t& size) const {
+        std::string_view text = field(line, m_options.column, first);
+        size = text.size();
+        Angle result;
+        if (!parse_angle(text, m_options.in_degrees, result)) { fail("cannot parse angle"); }
+        return result;
+    }
+    double degrees(std::string_view line, std::size_t& first, std::size_t& size) const {
+        std::string_view text = field(line, m_options.column, first);
+        size = text.size();
+        double result;
+        if (!parse_degrees(text, m_options.in_degrees, result)) { fail("cannot parse angle"); }
+        return result;
+    }
+    void write_angle(float rad) {
+        if (m_options.out_degrees) { m_writer.number(float(rad * Angle::calc_type(180) / Angle::pi)); }
+        else { m_writer.number(rad); }
+    }
+    AngleRange range(std::string_view line) const {
+        std::size_t first;
+        std::string_view text = trim(field(line, m_options.column, first));
+        AngleRange result(0, 0);
+        std::from_chars_result parsed = AngleRange::parse(text, result);
+        if (parsed.ec == std::errc() && parsed.ptr == text.data() + text.size()) { return result; }
+        Angle start, end;
+        if (!parse_angle(text, m_options.in_degrees, start)
+            || !parse_angle(field(line, m_options.column + 1, first), m_options.in_degrees, end)) {
+            fail("cannot parse range");
+        }
+        return AngleRange(start, end);
+    }
+    bool header(std::string_view& line) {
+        if (!m_reader.next(line)) { return false; }
+        ++m_line;
+        return true;
+    }
+
+    // Строка с заменённым полем угла; convert не приводит угол к [0, 2pi).
+    // Вывод в градусах считается в градусах, в double.
+    void transform(bool normalize) {
+        std::string_view line;
+        if (m_options.header && header(line)) {
+            m_writer.write(line);
+            m_writer.put('\n');
+        }
+        while (m_reader.next(line)) {
+            ++m_line;
+            if (line.empty()) { continue; }
+            std::size_t first, size;
+            if (m_options.out_degrees) {
+                double deg = degrees(line, first, size);
+                m_writer.write(line.substr(0, first));
+                m_writer.number(static_cast<float>(normalize ? normalize_degrees(deg) : deg));
+            }
+            else {
+                float rad = angle(line, first, size).getRadians();
+                m_writer.write(line.substr(0, first));
+                m_writer.number(normalize ? Angle::normalize(rad) : rad);
+            }
+            m_writer.write(line.substr(first + size));
+            m_writer.put('\n');
+        }
+    }
+    void filter() {
+        AngleRange arc(0, 0);
+        std::from_chars_result parsed = AngleRange::parse(m_options.range, arc);
+        if (parsed.ec != std::errc() || parsed.ptr != m_options.range.data() + m_options.range.size()) {
+            throw std::invalid_argument("Cannot parse range " + m_options.range);
+        }
+        std::string_view line;
+        if (m_options.header && header(line)) {
+            m_writer.write(line);
+            m_writer.put('\n');
+        }
+        while (m_reader.next(line)) {
+            ++m_line;
+            if (line.empty()) { continue; }
+            std::size_t first, size;
+            if (arc.contains(angle(line, first, size))) {
+                m_writer.write(line);
+                m_writer.put('\n');
+            }
+        }
+    }
+    void unite() {
+        std::string_view line;
+        char delimiter = m_options.delimiter;
+        if (m_options.header && header(line)) {
+            m_writer.write("start");
+            for (const char* name : {"end", "includes_start", "includes_end"}) {
+                m_writer.put(delimiter);
+                m_writer.write(name);
+            }
+            m_writer.put('\n');
+        }
+        AngleRangeSet set;
+        while (m_reader.next(line)) {
+            ++m_line;
+            if (!line.empty()) { set += range(line); }
+        }
+        for (const AngleRange& part : set.ranges()) {
+            write_angle(part.getStart().getRadians());
+            m_writer.put(delimiter);
+            write_angle(part.getEnd().getRadians());
+            m_writer.put(delimiter);
+            m_writer.put(part.includesStart() ? '1' : '0');
+            m_writer.put(delimiter);
+            m_writer.put(part.includesEnd() ? '1' : '0');
+            m_writer.put('\n');
+        }
+    }
+public:
+    Tool(const Options& options, std::FILE* input, std::FILE* output):
+        m_options(options), m_reader(input), m_writer(output) {}
+    void run() {
+        if (m_options.command == "normalize") { transform(true); }
+        else if (m_options.command == "convert") { transform(false); }
+        else if (m_options.command == "filter") { filter(); }
+        else if (m_options.command == "union") { unite(); }
+        else { throw std::invalid_argument("Unknown command " + m_options.command); }
+        m_writer.flush();
+    }
+};
+
+bool parse_unit(const char* text) {
+    std::string_view unit = text;
+    if (unit != "deg" && unit != "rad") { throw std::invalid_argument("Unknown unit " + std::string(unit)); }
+    return unit == "deg";
+}
+
+Options parse_options(int argc, char** argv) {
+    Options options;
+    int i = 1;
+    if (i < argc) { options.command = argv[i++]; }
+    if (options.command == "filter" && i < argc) { options.range = argv[i++]; }
+    for (; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        bool needs_value = arg == "--column" || arg == "--delimiter" || arg == "--in" || arg == "--out";
+        if (needs_value && i + 1 == argc) { throw std::invalid_argument("Missing value for " + std::string(arg)); }
+        if (arg == "--column") {
+            std::string_view value = argv[++i];
+            std::from_chars_result parsed = std::from_chars(value.data(), value.data() + value.size(), options.column);
+            if (parsed.ec != std::errc() || parsed.ptr != value.data() + value.size() || options.column == 0) {
+                throw std::invalid_argument("--column expects a column number from 1, got '" + std::string(value) + "'");
+            }
+            --options.column;
+        }
+        else if (arg == "--delimiter") { options.delimiter = argv[++i][0]; }
+        else if (arg == "--tsv") { options.delimiter = '\t'; }
+        else if (arg == "--in") { options.in_degrees = parse_unit(argv[++i]); }
+        else if (arg == "--out") { options.out_degrees = parse_unit(argv[++i]); }
+        else if (arg == "--header") { options.header = true; }
+        else if (!options.input && arg[0] != '-') { options.input = argv[i]; }
+        else { throw std::invalid_argument("Unknown option " + std::string(arg)); }
+    }
+    if (options.command.empty() || (options.command == "filter" && options.range.empty())) {
+        throw std::invalid_argument("Usage: angle_tool normalize|convert|filter <range>|union [options] [file]");
+    }
+    return options;
+}
+
+int main(int argc, char** argv) {
+    try {
+        Options options = parse_options(argc, argv);
+        std::FILE* input = options.input ? std::fopen(options.input, "rb") : stdin;
+        if (!input) { throw std::invalid_argument("Cannot open " + std::string(options.input)); }
+        Tool(options, input, stdout).run();
+        if (input != stdin) { std::fclose(input); }
+    }
+    catch (const std::exception& error) {
+        std::fprintf(stderr, "%s\n", error.what());
+        return 1;
+    }
+    return 0;
+}
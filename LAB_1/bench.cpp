@@ -0,0 +1,684 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "bench.h"
+#include "angle.h"
+#include "binary_angle.h"
+#include "angle_buffer.h"
+#include "angle_range_set.h"
+#include "angle_file.h"
+#include "packed_angle_range.h"
+#include "rotation.h"
+#include "circular_stats.h"
+#include "angle_range_index.h"
+#include "sector_classifier.h"
+#include "coverage_profile.h"
+
+
+// noinline: иначе GCC видит malloc и free в месте вызова и считает
+// new и delete несогласованными (-Wmismatched-new-delete).
+[[gnu::noinline]] void* operator new(std::size_t size) {
+    bench::allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1)) { return ptr; }
+    throw std::bad_alloc();
+}
+[[gnu::noinline]] void operator delete(void* ptr) noexcept { std::free(ptr); }
+[[gnu::noinline]] void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+struct Distribution {
+    const char* name;
+    float lo;
+    float hi;
+};
+
+const Distribution angle_distributions[] = {
+    {"normalized", 0, 2 * M_PI},
+    {"negative", -2 * M_PI, 0},
+    {"mixed", -4 * M_PI, 4 * M_PI},
+    {"large", -1e6, 1e6},
+};
+
+const std::size_t n = 1 << 14;
+
+void bench_angle(const Distribution& dist) {
+    const std::string suffix = std::string("/") + dist.name;
+    std::vector<float> rads = bench::uniform(n, dist.lo, dist.hi);
+    std::vector<float> degs = bench::uniform(n, dist.lo * 180 / M_PI, dist.hi * 180 / M_PI, 7);
+    std::vector<Angle> angles(rads.begin(), rads.end());
+    std::vector<Angle> others(angles.rbegin(), angles.rend());
+    std::vector<NormalizedAngle> normalized(angles.begin(), angles.end());
+    std::vector<BinaryAngle> binary(angles.begin(), angles.end());
+    std::vector<Angle> out(n);
+    std::vector<int> degrees(n);
+    std::vector<uint8_t> mask(n);
+
+    bench::run("Angle::normalize" + suffix, n, [&] {
+        for (std::size_t i = 0; i < n; ++i) { out[i] = Angle::normalize(rads[i]); }
+        bench::do_not_optimize(out);
+    });
+    bench::run("Angle::from_degrees" + suffix, n, [&] {
+        for (std::size_t i = 0; i < n; ++i) { out[i] = Angle::from_degrees(degs[i]); }
+        bench::do_not_optimize(out);
+    });
+    bench::run("Angle::getDegrees" + suffix, n, [&] {
+        for (std::size_t i = 0; i < n; ++i) { degrees[i] = angles[i].getDegrees(); }
+        bench::do_not_optimize(degrees);
+    });
+    bench::run("Angle::operator+" + suffix, n, [&] {
+        for (std::size_t i = 0; i < n; ++i) { out[i] = angles[i] + others[i]; }
+        bench::do_not_optimize(out);
+    });
+    bench::run("Angle::operator*" + suffix, n, [&] {
+        for (std::size_t i = 0; i < n; ++i) { out[i] = angles[i] * 1.5f; }
+        bench::do_not_optimize(out);
+    });
+    bench::run("Angle::operator/" + suffix, n, [&] {
+        for (std::size_t i = 0; i < n; ++i) { out[i] = angles[i] / 3.0f; }
+        bench::do_not_optimize(out);
+    });
+    bench::run("Angle::operator==" + suffix, n, [&] {
+        for (std::size_t i = 0; i < n; ++i) { mask[i] = angles[i] == others[i]; }
+        bench::do_not_optimize(mask);
+    });
+    bench::run("Angle::operator<" + suffix, n, [&] {
+        for (std::size_t i = 0; i < n; ++i) { mask[i] = angles[i] < others[i]; }
+        bench::do_not_optimize(mask);
+    });
+    bench::run("Angle sort" + suffix, n, [&] {
+        std::vector<Angle> copy = angles;
+        std::sort(copy.begin(), copy.end());
+        bench::do_not_optimize(copy);
+    });
+    bench::run("Angle::str" + suffix, n / 16, [&] {
+        for (std::size_t i = 0; i < n / 16; ++i) { bench::do_not_optimize(angles[i].str()); }
+    });
+    bench::run("Angle::repr" + suffix, n / 16, [&] {
+        for (std::size_t i = 0; i < n / 16; ++i) { bench::do_not_optimize(angles[i].repr()); }
+    });
+    bench::run("Angle::to_chars" + suffix, n / 16, [&] {
+        char buffer[Angle::max_str_size];
+        for (std::size_t i = 0; i < n / 16; ++i) {
+            bench::do_not_optimize(angles[i].to_chars(buffer, buffer + sizeof(buffer)).ptr);
+        }
+    });
+    bench::run("Angle::repr_to_chars" + suffix, n / 16, [&] {
+        char buffer[Angle::max_repr_size];
+        for (std::size_t i = 0; i < n / 16; ++i) {
+            bench::do_not_optimize(angles[i].repr_to_chars(buffer, buffer + sizeof(buffer)).ptr);
+        }
+    });
+    std::vector<float> sines(n), cosines(n);
+    bench::run("std::sin+std::cos" + suffix, n, [&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            sines[i] = std::sin(angles[i].getRadians());
+            cosines[i] = std::cos(angles[i].getRadians());
+        }
+        bench::do_not_optimize(sines);
+        bench::do_not_optimize(cosines);
+    });
+    const std::pair<const char*, TrigAccuracy> accuracies[] = {
+        {"exact", TrigAccuracy::exact}, {"fast", TrigAccuracy::fast}, {"table", TrigAccuracy::table},
+    };
+    for (auto [accuracy_name, accuracy] : accuracies) {
+        const std::string tier = std::string("(") + accuracy_name + ")" + suffix;
+        bench::run("Angle::sincos" + tier, n, [&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                SinCos<float> v = angles[i].sincos(accuracy);
+                sines[i] = v.sin;
+                cosines[i] = v.cos;
+            }
+            bench::do_not_optimize(sines);
+            bench::do_not_optimize(cosines);
+        });
+        bench::run("Angle::sincos batch" + tier, n, [&] {
+            Angle::sincos(rads, sines, cosines, accuracy);
+            bench::do_not_optimize(sines);
+            bench::do_not_optimize(cosines);
+        });
+        bench::run("Angle::tan batch" + tier, n, [&] {
+            Angle::tan(rads, sines, accuracy);
+            bench::do_not_optimize(sines);
+        });
+    }
+
+    std::vector<float> xs(n), ys(n), directions(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        xs[i] = std::cos(rads[i]) * (1 + degs[i] * 1e-3f);
+        ys[i] = std::sin(rads[i]) * (1 + degs[i] * 1e-3f);
+    }
+    bench::run("Angle::from_radians(std::atan2).normalize" + suffix, n, [&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = Angle::normalize(Angle::from_radians(std::atan2(ys[i], xs[i])).getRadians());
+        }
+        bench::do_not_optimize(out);
+    });
+    bench::run("Angle::from_vector(exact)" + suffix, n, [&] {
+        for (std::size_t i = 0; i < n; ++i) { out[i] = Angle::from_vector(xs[i], ys[i]); }
+        bench::do_not_optimize(out);
+    });
+    bench::run("Angle::from_vector batch(exact)" + suffix, n, [&] {
+        Angle::from_vector(xs, ys, directions);
+        bench::do_not_optimize(directions);
+    });
+    bench::run("Angle::from_vector batch(fast)" + suffix, n, [&] {
+        Angle::from_vector(xs, ys, directions, TrigAccuracy::fast);
+        bench::do_not_optimize(directions);
+    });
+
+    std::vector<std::string> texts;
+    for (std::size_t i = 0; i < n / 16; ++i) { texts.push_back(angles[i].repr()); }
+    bench::run("Angle stod+from_radians" + suffix, n / 16, [&] {
+        for (std::size_t i = 0; i < n / 16; ++i) {
+            bench::do_not_optimize(Angle::from_radians(std::stof(texts[i].substr(6))));
+        }
+    });
+    bench::run("Angle::parse" + suffix, n / 16, [&] {
+        Angle angle;
+        for (std::size_t i = 0; i < n / 16; ++i) {
+            bench::do_not_optimize(Angle::parse(texts[i], angle).ptr);
+            bench::do_not_optimize(angle);
+        }
+    });
+
+    bench::run("NormalizedAngle(Angle)" + suffix, n, [&] {
+        std::vector<NormalizedAngle> copy(angles.begin(), angles.end());
+        bench::do_not_optimize(copy);
+    });
+    bench::run("NormalizedAngle::operator<" + suffix, n, [&] {
+        for (std::size_t i = 0; i < n; ++i) { mask[i] = normalized[i] < normalized[n - 1 - i]; }
+        bench::do_not_optimize(mask);
+    });
+    bench::run("NormalizedAngle sort" + suffix, n, [&] {
+        std::vector<NormalizedAngle> copy = normalized;
+        std::sort(copy.begin(), copy.end());
+        bench::do_not_optimize(copy);
+    });
+
+    bench::run("BinaryAngle(Angle)" + suffix, n, [&] {
+        std::vector<BinaryAngle> copy(angles.begin(), angles.end());
+        bench::do_not_optimize(copy);
+    });
+    bench::run("BinaryAngle::operator+" + suffix, n, [&] {
+        BinaryAngle sum;
+        for (const BinaryAngle& a : binary) { sum = sum + a; }
+        bench::do_not_optimize(sum);
+    });
+    bench::run("BinaryAngle sort" + suffix, n, [&] {
+        std::vector<BinaryAngle> copy = binary;
+        std::sort(copy.begin(), copy.end());
+        bench::do_not_optimize(copy);
+    });
+
+    AngleBuffer buffer{std::span<const float>(rads)};
+    bench::run("AngleBuffer::from_degrees" + suffix, n, [&] {
+        bench::do_not_optimize(AngleBuffer::from_degrees(degs));
+    });
+    bench::run("AngleBuffer::add+normalize" + suffix, n, [&] {
+        AngleBuffer copy = buffer;
+        copy.add(Angle(0.5f)).normalize();
+        bench::do_not_optimize(copy);
+    });
+    bench::run("AngleBuffer::scale" + suffix, n, [&] {
+        AngleBuffer copy = buffer;
+        copy.scale(1.5f);
+        bench::do_not_optimize(copy);
+    });
+    bench::run("AngleBuffer::to_degrees" + suffix, n, [&] {
+        buffer.to_degrees(degrees);
+        bench::do_not_optimize(degrees);
+    });
+    bench::run("AngleBuffer::less" + suffix, n, [&] {
+        buffer.less(Angle(1.0f), mask);
+        bench::do_not_optimize(mask);
+    });
+}
+
+std::vector<AngleRange> make_ranges(std::size_t count, float lo, float hi, float max_width, unsigned seed) {
+    std::vector<float> starts = bench::uniform(count, lo, hi, seed);
+    std::vector<float> widths = bench::uniform(count, 0, max_width, seed + 1);
+    std::vector<AngleRange> ranges;
+    ranges.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        ranges.push_back(AngleRange(starts[i], starts[i] + widths[i], i % 2 == 0, i % 3 == 0));
+    }
+    return ranges;
+}
+
+void bench_range(const std::string& name, const std::vector<AngleRange>& ranges) {
+    const std::string suffix = "/" + name;
+    std::vector<float> rads = bench::uniform(n, -M_PI, 3 * M_PI, 11);
+    std::vector<Angle> angles(rads.begin(), rads.end());
+    std::vector<NormalizedAngle> normalized(angles.begin(), angles.end());
+    std::vector<uint8_t> mask(n);
+    std::vector<std::size_t> indices(n);
+    const std::size_t count = ranges.size();
+    std::vector<double> lengths(count);
+
+    bench::run("AngleRange::contains(Angle)" + suffix, n, [&] {
+        for (std::size_t i = 0; i < n; ++i) { mask[i] = ranges[i % count].contains(angles[i]); }
+        bench::do_not_optimize(mask);
+    });
+    bench::run("AngleRange::contains(NormalizedAngle)" + suffix, n, [&] {
+        for (std::size_t i = 0; i < n; ++i) { mask[i] = ranges[i % count].contains(normalized[i]); }
+        bench::do_not_optimize(mask);
+    });
+    bench::run("AngleRange::contains(AngleRange)" + suffix, count, [&] {
+        for (std::size_t i = 0; i < count; ++i) { mask[i] = ranges[i].contains(ranges[count - 1 - i]); }
+        bench::do_not_optimize(mask);
+    });
+    bench::run("AngleRange::contains mask" + suffix, n, [&] {
+        ranges[0].contains(std::span<const float>(rads), mask);
+        bench::do_not_optimize(mask);
+    });
+    bench::run("AngleRange::contains_indices" + suffix, n, [&] {
+        bench::do_not_optimize(ranges[0].contains_indices(std::span<const float>(rads), indices));
+    });
+    bench::run("AngleRange::length" + suffix, count, [&] {
+        for (std::size_t i = 0; i < count; ++i) { lengths[i] = ranges[i].length(); }
+        bench::do_not_optimize(lengths);
+    });
+    bench::run("AngleRange::operator+" + suffix, count, [&] {
+        for (std::size_t i = 0; i < count; ++i) { bench::do_not_optimize(ranges[i] + ranges[count - 1 - i]); }
+    });
+    bench::run("AngleRange::operator-" + suffix, count, [&] {
+        for (std::size_t i = 0; i < count; ++i) { bench::do_not_optimize(ranges[i] - ranges[count - 1 - i]); }
+    });
+    bench::run("AngleRange::operator&" + suffix, count, [&] {
+        for (std::size_t i = 0; i < count; ++i) { bench::do_not_optimize(ranges[i] & ranges[count - 1 - i]); }
+    });
+    bench::run("AngleRange::str" + suffix, count, [&] {
+        for (std::size_t i = 0; i < count; ++i) { bench::do_not_optimize(ranges[i].str()); }
+    });
+    bench::run("AngleRange::repr" + suffix, count, [&] {
+        for (std::size_t i = 0; i < count; ++i) { bench::do_not_optimize(ranges[i].repr()); }
+    });
+    bench::run("AngleRange::to_chars" + suffix, count, [&] {
+        char buffer[AngleRange::max_str_size];
+        for (std::size_t i = 0; i < count; ++i) {
+            bench::do_not_optimize(ranges[i].to_chars(buffer, buffer + sizeof(buffer)).ptr);
+        }
+    });
+    bench::run("AngleRange::repr_to_chars" + suffix, count, [&] {
+        char buffer[AngleRange::max_repr_size];
+        for (std::size_t i = 0; i < count; ++i) {
+            bench::do_not_optimize(ranges[i].repr_to_chars(buffer, buffer + sizeof(buffer)).ptr);
+        }
+    });
+    std::vector<std::string> texts;
+    for (const AngleRange& range : ranges) { texts.push_back(range.repr()); }
+    bench::run("AngleRange::parse" + suffix, count, [&] {
+        AngleRange range(0, 0);
+        for (std::size_t i = 0; i < count; ++i) {
+            bench::do_not_optimize(AngleRange::parse(texts[i], range).ptr);
+            bench::do_not_optimize(range);
+        }
+    });
+    std::ostringstream log;
+    bench::run("AngleRange::operator<<" + suffix, count, [&] {
+        log.seekp(0);
+        for (std::size_t i = 0; i < count; ++i) { log << ranges[i] << '\n'; }
+        bench::do_not_optimize(log);
+    });
+
+    AngleRangeSet coverage{std::span<const AngleRange>(ranges)};
+    bench::run("AngleRangeSet build" + suffix, count, [&] {
+        AngleRangeSet set;
+        for (const AngleRange& r : ranges) { set += r; }
+        bench::do_not_optimize(set);
+    });
+    bench::run("AngleRangeSet::union_all" + suffix, count, [&] {
+        bench::do_not_optimize(AngleRangeSet::union_all(ranges));
+    });
+    bench::run("AngleRangeSet::contains" + suffix, n, [&] {
+        for (std::size_t i = 0; i < n; ++i) { mask[i] = coverage.contains(angles[i]); }
+        bench::do_not_optimize(mask);
+    });
+    bench::run("AngleRangeSet::complement" + suffix, count, [&] {
+        AngleRangeSet copy = coverage;
+        copy.complement();
+        bench::do_not_optimize(copy);
+    });
+}
+
+// Рост вектора и копирование массивов сводятся к memcpy только для тривиально копируемых типов.
+template <typename Value>
+void bench_copy(const std::string& name, const std::vector<Value>& values) {
+    const std::size_t count = values.size();
+    bench::run(name + " vector growth", count, [&] {
+        std::vector<Value> grown;
+        for (const Value& value : values) { grown.push_back(value); }
+        bench::do_not_optimize(grown);
+    });
+    std::vector<Value> copy(count, values[0]);
+    bench::run(name + " std::copy", count, [&] {
+        std::copy(values.begin(), values.end(), copy.begin());
+        bench::do_not_optimize(copy);
+    });
+    bench::run(name + " to_bytes+from_bytes", count, [&] {
+        bench::do_not_optimize(Value::from_bytes(Value::to_bytes(values), copy));
+        bench::do_not_optimize(copy);
+    });
+}
+
+// Какие дуги большой таблицы покрытия содержат угол: упакованные дуги на треть короче.
+void bench_packed(const std::string& name, float lo, float hi) {
+    const std::string suffix = "/" + name;
+    const std::size_t count = 1 << 20;
+    std::vector<AngleRange> ranges = make_ranges(count, lo, hi, 4.0f, 8);
+    std::vector<PackedAngleRange> packed(ranges.begin(), ranges.end());
+    std::vector<float> probes = bench::uniform(8, 0, 2 * M_PI, 9);
+    std::vector<uint8_t> mask(count);
+
+    bench::run("AngleRange coverage scan" + suffix, count * probes.size(), [&] {
+        for (float probe : probes) {
+            NormalizedAngle angle{Angle(probe)};
+            for (std::size_t i = 0; i < count; ++i) { mask[i] = ranges[i].contains(angle); }
+            bench::do_not_optimize(mask);
+        }
+    });
+    bench::run("PackedAngleRange coverage scan" + suffix, count * probes.size(), [&] {
+        for (float probe : probes) {
+            NormalizedAngle angle{Angle(probe)};
+            for (std::size_t i = 0; i < count; ++i) { mask[i] = packed[i].contains(angle); }
+            bench::do_not_optimize(mask);
+        }
+    });
+    bench::run("PackedAngleRange::contains mask" + suffix, count * probes.size(), [&] {
+        for (float probe : probes) {
+            PackedAngleRange::contains(packed, Angle(probe), mask);
+            bench::do_not_optimize(mask);
+        }
+    });
+}
+
+// Повторное открытие набора данных: текст приходится разбирать заново, файл - только отобразить.
+void bench_file() {
+    const std::size_t count = 1 << 20;
+    const std::string path = "bench_angles.bin";
+    std::vector<float> rads = bench::uniform(count, -4 * M_PI, 4 * M_PI, 5);
+    std::string text;
+    char buffer[Angle::max_repr_size];
+    for (float rad : rads) {
+        text.append(buffer, Angle(rad).repr_to_chars(buffer, buffer + sizeof(buffer)).ptr);
+        text += '\n';
+    }
+    AngleFile::write(path, std::span<const float>(rads));
+    AngleRange range(Angle::from_degrees(350), Angle::from_degrees(10));
+    std::vector<uint8_t> mask(count);
+    std::vector<float> parsed(count);
+
+    bench::run("AngleFile text parse+contains", count, [&] {
+        const char* first = text.data();
+        const char* last = first + text.size();
+        Angle angle;
+        for (std::size_t i = 0; i < count; ++i) {
+            first = Angle::parse(first, last, angle).ptr + 1;
+            parsed[i] = angle.getRadians();
+        }
+        range.contains(std::span<const float>(parsed), mask);
+        bench::do_not_optimize(mask);
+    });
+    bench::run("AngleFile open", count, [&] {
+        AngleFile file(path);
+        bench::do_not_optimize(file.radians()[count - 1]);
+    });
+    bench::run("AngleFile open+contains", count, [&] {
+        AngleFile file(path);
+        range.contains(file.radians(), mask);
+        bench::do_not_optimize(mask);
+    });
+    std::remove(path.c_str());
+}
+
+// Поворот облака точек: sin и cos на каждую точку против одного Rotation2D на всё облако.
+void bench_rotation() {
+    const std::size_t count = 1 << 16;
+    std::vector<float> xs = bench::uniform(count, -100, 100, 10);
+    std::vector<float> ys = bench::uniform(count, -100, 100, 11);
+    std::vector<float> out_x(count), out_y(count);
+    Angle angle(0.7f);
+
+    bench::run("rotate std::sin+std::cos per point", count, [&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            float sin = std::sin(angle.getRadians()), cos = std::cos(angle.getRadians());
+            bench::do_not_optimize(sin);
+            out_x[i] = cos * xs[i] - sin * ys[i];
+            out_y[i] = sin * xs[i] + cos * ys[i];
+        }
+        bench::do_not_optimize(out_y);
+    });
+    bench::run("Rotation2D::apply scalar", count, [&] {
+        Rotation2D rotation(angle);
+        for (std::size_t i = 0; i < count; ++i) {
+            float x = xs[i], y = ys[i];
+            rotation.apply(x, y);
+            out_x[i] = x;
+            out_y[i] = y;
+        }
+        bench::do_not_optimize(out_y);
+    });
+    bench::run("Rotation2D::apply batch", count, [&] {
+        Rotation2D(angle).apply(xs, ys, out_x, out_y);
+        bench::do_not_optimize(out_y);
+    });
+    Rotation2D step(Angle::from_degrees(1));
+    bench::run("Rotation2D compose", 1024, [&] {
+        Rotation2D total;
+        for (std::size_t i = 0; i < 1024; ++i) { total += step; }
+        bench::do_not_optimize(total);
+    });
+    bench::run("Rotation2D from summed Angle", 1024, [&] {
+        Angle total(0.0f);
+        for (std::size_t i = 0; i < 1024; ++i) {
+            total = total + step.angle();
+            bench::do_not_optimize(Rotation2D(total));
+        }
+    });
+}
+
+// Среднее направление большого массива: цикл по Angle против CircularStats в одном и во всех потоках.
+void bench_stats() {
+    const std::size_t count = 1 << 22;
+    std::vector<float> rads = bench::uniform(count, -4 * M_PI, 4 * M_PI, 12);
+    std::vector<float> weights = bench::uniform(count, 0, 1, 13);
+
+    bench::run("circular mean loop over Angle", count, [&] {
+        double sin = 0, cos = 0;
+        for (float rad : rads) {
+            SinCos<float> v = Angle(rad).sincos();
+            sin += v.sin;
+            cos += v.cos;
+        }
+        bench::do_not_optimize(std::atan2(sin, cos));
+    });
+    for (TrigAccuracy accuracy : {TrigAccuracy::exact, TrigAccuracy::fast}) {
+        const std::string tier = accuracy == TrigAccuracy::exact ? "exact" : "fast";
+        bench::run("CircularStats::compute(" + tier + ") 1 thread", count, [&] {
+            bench::do_not_optimize(CircularStats::compute(rads, accuracy, 1).mean());
+        });
+        bench::run("CircularStats::compute(" + tier + ") all threads", count, [&] {
+            bench::do_not_optimize(CircularStats::compute(rads, accuracy).mean());
+        });
+        bench::run("CircularStats::compute weighted(" + tier + ") all threads", count, [&] {
+            bench::do_not_optimize(CircularStats::compute(rads, weights, accuracy).mean());
+        });
+    }
+}
+
+// Статистика по скользящему окну: пересчёт окна на каждом отсчёте против CircularWindow.
+void bench_window() {
+    const std::size_t count = 1 << 20;
+    const std::size_t window = 1024;
+    std::vector<float> rads = bench::uniform(count, -4 * M_PI, 4 * M_PI, 14);
+
+    bench::run("window recompute per sample", 4096, [&] {
+        for (std::size_t i = window; i < window + 4096; ++i) {
+            std::span<const float> last(rads.data() + i - window, window);
+            bench::do_not_optimize(CircularStats::compute(last, TrigAccuracy::exact, 1).mean());
+        }
+    });
+    for (TrigAccuracy accuracy : {TrigAccuracy::exact, TrigAccuracy::fast}) {
+        const std::string tier = accuracy == TrigAccuracy::exact ? "exact" : "fast";
+        bench::run("CircularWindow::push+mean(" + tier + ")", count, [&] {
+            CircularWindow stream(window, accuracy);
+            for (float rad : rads) {
+                stream.push(Angle(rad));
+                bench::do_not_optimize(stream.mean());
+            }
+        });
+        bench::run("CircularWindow::push batch(" + tier + ")", count, [&] {
+            CircularWindow stream(window, accuracy);
+            stream.push(rads);
+            bench::do_not_optimize(stream.mean());
+        });
+    }
+}
+
+// Какие из многих узких дуг содержат угол: обход всех дуг против AngleRangeIndex.
+void bench_index() {
+    const std::size_t count = 1 << 15;
+    std::vector<AngleRange> ranges = make_ranges(count, -2 * M_PI, 4 * M_PI, 0.05f, 15);
+    std::vector<float> probes = bench::uniform(4096, -4 * M_PI, 4 * M_PI, 16);
+    std::vector<std::size_t> hits, offsets;
+
+    bench::run("AngleRange::contains over all ranges", probes.size(), [&] {
+        for (float probe : probes) {
+            hits.clear();
+            Angle angle(probe);
+            for (std::size_t i = 0; i < count; ++i) {
+                if (ranges[i].contains(angle)) { hits.push_back(i); }
+            }
+            bench::do_not_optimize(hits);
+        }
+    });
+    bench::run("AngleRangeIndex build", count, [&] {
+        AngleRangeIndex index(ranges);
+        bench::do_not_optimize(index);
+    });
+    AngleRangeIndex index(ranges);
+    bench::run("AngleRangeIndex::query", probes.size(), [&] {
+        for (float probe : probes) {
+            hits.clear();
+            index.query(Angle(probe), hits);
+            bench::do_not_optimize(hits);
+        }
+    });
+    bench::run("AngleRangeIndex::query batch", probes.size(), [&] {
+        index.query(probes, offsets, hits);
+        bench::do_not_optimize(hits);
+    });
+}
+
+// Номер сектора для каждого угла: проверка секторов по очереди против SectorClassifier.
+void bench_sectors(std::size_t sectors) {
+    const std::string suffix = std::string("/") + std::to_string(sectors);
+    const std::size_t count = 1 << 16;
+    std::vector<AngleRange> ranges;
+    for (std::size_t i = 0; i < sectors; ++i) {
+        ranges.push_back(AngleRange(float(2 * M_PI * i / sectors), float(2 * M_PI * ((i + 1) % sectors) / sectors), true, false));
+    }
+    std::vector<float> rads = bench::uniform(count, -2 * M_PI, 4 * M_PI, 17);
+    std::vector<uint32_t> out(count);
+
+    bench::run("sector by AngleRange::contains" + suffix, count, [&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            Angle angle(rads[i]);
+            uint32_t sector = SectorClassifier::none;
+            for (std::size_t j = 0; j < sectors; ++j) {
+                if (ranges[j].contains(angle)) {
+                    sector = j;
+                    break;
+                }
+            }
+            out[i] = sector;
+        }
+        bench::do_not_optimize(out);
+    });
+    SectorClassifier classifier(ranges);
+    bench::run("SectorClassifier::classify" + suffix, count, [&] {
+        for (std::size_t i = 0; i < count; ++i) { out[i] = classifier.classify(Angle(rads[i])); }
+        bench::do_not_optimize(out);
+    });
+    bench::run("SectorClassifier::classify batch" + suffix, count, [&] {
+        classifier.classify(rads, out);
+        bench::do_not_optimize(out);
+    });
+}
+
+// Объединение многих дуг: вставка по одной против сортировки и одного прохода.
+void bench_union(const std::string& name, std::size_t count, float max_width) {
+    const std::string suffix = "/" + name;
+    std::vector<AngleRange> ranges = make_ranges(count, -2 * M_PI, 4 * M_PI, max_width, 18);
+
+    bench::run("AngleRangeSet += one by one" + suffix, count, [&] {
+        AngleRangeSet set;
+        for (const AngleRange& range : ranges) { set += range; }
+        bench::do_not_optimize(set);
+    });
+    bench::run("AngleRangeSet::union_all" + suffix, count, [&] {
+        bench::do_not_optimize(AngleRangeSet::union_all(ranges));
+    });
+    bench::run("AngleRangeSet::union_all all threads" + suffix, count, [&] {
+        bench::do_not_optimize(AngleRangeSet::union_all(ranges, 0));
+    });
+}
+
+// Глубина покрытия: перебор дуг для каждого угла против профиля покрытия.
+void bench_coverage() {
+    const std::size_t count = 1 << 14;
+    std::vector<AngleRange> ranges = make_ranges(count, -2 * M_PI, 4 * M_PI, 0.5f, 20);
+    std::vector<float> probes = bench::uniform(1024, 0, 2 * M_PI, 21);
+    std::vector<uint32_t> depth(probes.size());
+
+    bench::run("coverage depth by AngleRange::contains", probes.size(), [&] {
+        for (std::size_t i = 0; i < probes.size(); ++i) {
+            uint32_t covered = 0;
+            NormalizedAngle angle{Angle(probes[i])};
+            for (const AngleRange& range : ranges) { covered += range.contains(angle); }
+            depth[i] = covered;
+        }
+        bench::do_not_optimize(depth);
+    });
+    bench::run("CoverageProfile build", count, [&] {
+        CoverageProfile profile(ranges);
+        bench::do_not_optimize(profile.max_depth());
+    });
+    CoverageProfile profile(ranges);
+    bench::run("CoverageProfile::depth", probes.size(), [&] {
+        for (std::size_t i = 0; i < probes.size(); ++i) { depth[i] = profile.depth(Angle(probes[i])); }
+        bench::do_not_optimize(depth);
+    });
+    bench::run("CoverageProfile::max_ranges", 1, [&] {
+        bench::do_not_optimize(profile.max_ranges());
+    });
+}
+
+int main(int argc, char** argv) {
+    bench::init(argc, argv);
+    for (const Distribution& dist : angle_distributions) { bench_angle(dist); }
+    bench_range("narrow", make_ranges(1024, 0, 2 * M_PI - 0.5f, 0.5f, 1));
+    bench_range("wrap", make_ranges(1024, 2 * M_PI - 0.5f, 2 * M_PI, 1.0f, 2));
+    bench_range("large", make_ranges(1024, -1e6, 1e6, 0.5f, 3));
+    bench_range("wide", make_ranges(1024, 0, 2 * M_PI, 4.0f, 4));
+    bench_packed("normalized", 0, 2 * M_PI - 4);
+    bench_packed("raw", -2 * M_PI, 4 * M_PI);
+    bench_file();
+    bench_rotation();
+    bench_stats();
+    bench_window();
+    bench_index();
+    bench_sectors(16);
+    bench_sectors(360);
+    bench_union("sparse", 1 << 16, 1e-5f);
+    bench_union("dense", 1 << 16, 0.01f);
+    bench_coverage();
+    std::vector<float> rads = bench::uniform(1 << 16, -4 * M_PI, 4 * M_PI, 6);
+    bench_copy("Angle", std::vector<Angle>(rads.begin(), rads.end()));
+    bench_copy("AngleRange", make_ranges(1 << 16, 0, 2 * M_PI, 4.0f, 7));
+    return 0;
+}
@@ -0,0 +1,67 @@
+#ifndef BENCH_H
+#define BENCH_H
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+
+// Минимальная замена Google Benchmark, собирающаяся без сети: каждый замер
+// крутит тело не меньше min_time и печатает время на один элемент.
+// Первый аргумент командной строки - подстрока для отбора замеров по имени.
+namespace bench {
+    inline const char* filter = nullptr;
+    inline std::chrono::milliseconds min_time(200);
+    // Счётчик увеличивает operator new, подменённый в bench.cpp; atomic -
+    // потому что многопоточные замеры выделяют память одновременно.
+    inline std::atomic<std::size_t> allocations = 0;
+
+    template <typename T>
+    inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    inline void init(int argc, char** argv) {
+        if (argc > 1) { filter = argv[1]; }
+    }
+
+    template <typename F>
+    void run(const std::string& name, std::size_t items, F body) {
+        if (filter && name.find(filter) == std::string::npos) { return; }
+        using clock = std::chrono::steady_clock;
+        body();
+        std::size_t iterations = 0;
+        std::size_t allocated = allocations.load(std::memory_order_relaxed);
+        clock::duration total{};
+        while (total < min_time) {
+            auto start = clock::now();
+            body();
+            total += clock::now() - start;
+            ++iterations;
+        }
+        double ns = std::chrono::duration<double, std::nano>(total).count() / (iterations * items);
+        double allocs = double(allocations.load(std::memory_order_relaxed) - allocated) / (iterations * items);
+        std::cout << std::left << std::setw(56) << name << std::right << std::setw(12)
+                  << std::fixed << std::setprecision(2) << ns << " ns/item" << std::setw(10)
+                  << allocs << " allocs/item" << std::endl;
+    }
+
+    inline std::vector<float> uniform(std::size_t n, float lo, float hi, unsigned seed = 42) {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<float> dist(lo, hi);
+        std::vector<float> result(n);
+        for (float& value : result) { value = dist(gen); }
+        return result;
+    }
+}
+
+#endif
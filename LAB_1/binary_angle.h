@@ -0,0 +1,104 @@
+#ifndef BINARY_ANGLE_H
+#define BINARY_ANGLE_H
+#include <cstdint>
+#include "angle.h"
+
+
+// Угол в формате BAM: полный оборот 2pi соответствует 2^32, поэтому
+// переполнение uint32_t и есть приведение к [0, 2pi) и normalize не нужен.
+class BinaryAngle {
+    uint32_t m_bam;
+    static constexpr double units_per_rad = 4294967296.0 / (2 * M_PI);
+    static constexpr double rad_per_unit = (2 * M_PI) / 4294967296.0;
+    static constexpr uint32_t eq_tolerance = 1e-6 * units_per_rad;
+    static uint32_t to_bam(double rad) {
+        double units = rad * units_per_rad;
+        if (!(std::fabs(units) < 9.2e18)) { units = fmod(units, 4294967296.0); }
+        return static_cast<uint32_t>(static_cast<uint64_t>(static_cast<int64_t>(std::floor(units + 0.5))));
+    }
+public:
+    BinaryAngle(): m_bam(0) {}
+    // Из float и Angle - только явно: при неявном переводе в обе стороны
+    // сравнение Angle с BinaryAngle в C++20 неоднозначно.
+    explicit BinaryAngle(float rad): m_bam(to_bam(rad)) {}
+    template <typename T>
+    explicit BinaryAngle(const BasicAngle<T>& angle): m_bam(to_bam(angle.getRadians())) {}
+    static BinaryAngle from_bam(uint32_t bam) {
+        BinaryAngle result;
+        result.m_bam = bam;
+        return result;
+    }
+    static BinaryAngle from_radians(float rad) { return BinaryAngle(rad); }
+    static BinaryAngle from_degrees(double deg) { return from_bam(to_bam(deg * M_PI / 180.0)); }
+    uint32_t getBam() const { return m_bam; }
+    float getRadians() const { return m_bam * rad_per_unit; }
+    // Почти полный оборот округляется до 360, а это уже 0.
+    int getDegrees() const {
+        int deg = std::round(m_bam * rad_per_unit * 180.0 / M_PI);
+        return deg >= 360 ? deg - 360 : deg;
+    }
+    BinaryAngle& setRadians(float rad) {
+        m_bam = to_bam(rad);
+        return *this;
+    }
+    BinaryAngle& setDegrees(float deg) {
+        m_bam = to_bam(deg * M_PI / 180.0);
+        return *this;
+    }
+    template <typename T>
+    operator BasicAngle<T>() const { return BasicAngle<T>(m_bam * rad_per_unit); }
+    explicit operator float() const { return getRadians(); }
+    explicit operator int() const { return static_cast<int>(getRadians()); }
+    operator std::string() const { return std::to_string(getRadians()); }
+    BinaryAngle operator+(const BinaryAngle& other) const { return from_bam(m_bam + other.m_bam); }
+    BinaryAngle operator+(double rad) const { return from_bam(m_bam + to_bam(rad)); }
+    BinaryAngle operator-(const BinaryAngle& other) const { return from_bam(m_bam - other.m_bam); }
+    BinaryAngle operator-(float rad) const { return from_bam(m_bam - to_bam(rad)); }
+    BinaryAngle operator*(float factor) const { return from_bam(to_bam(m_bam * rad_per_unit * factor)); }
+    BinaryAngle operator/(float divisor) const {
+        if (divisor == 0) { throw std::invalid_argument("Division by zero"); }
+        return from_bam(to_bam(m_bam * rad_per_unit / divisor));
+    }
+    static constexpr std::size_t max_str_size = 16;
+    static constexpr std::size_t max_repr_size = detail::radians_size<float> + 18;
+    // Запись str() и repr() в буфер вызывающего без выделения памяти, как у Angle.
+    std::to_chars_result to_chars(char* first, char* last) const {
+        std::to_chars_result result = std::to_chars(first, last, getDegrees());
+        if (result.ec != std::errc()) { return result; }
+        return detail::write_text(result.ptr, last, " deg");
+    }
+    std::to_chars_result repr_to_chars(char* first, char* last) const {
+        std::to_chars_result result = detail::write_text(first, last, "BinaryAngle(");
+        if (result.ec == std::errc()) { result = detail::write_radians(result.ptr, last, getRadians()); }
+        if (result.ec == std::errc()) { result = detail::write_text(result.ptr, last, " rad)"); }
+        return result;
+    }
+    std::string str() const {
+        char buffer[max_str_size];
+        return std::string(buffer, to_chars(buffer, buffer + max_str_size).ptr);
+    }
+    std::string repr() const {
+        char buffer[max_repr_size];
+        return std::string(buffer, repr_to_chars(buffer, buffer + max_repr_size).ptr);
+    }
+    bool operator==(const BinaryAngle& other) const {
+        uint32_t diff = m_bam - other.m_bam;
+        return diff < eq_tolerance || 0u - diff < eq_tolerance;
+    }
+    bool operator!=(const BinaryAngle& other) const { return !(*this == other); }
+    bool operator<(const BinaryAngle& other) const { return m_bam < other.m_bam; }
+    bool operator>(const BinaryAngle& other) const { return m_bam > other.m_bam; }
+    bool operator<=(const BinaryAngle& other) const { return m_bam <= other.m_bam; }
+    bool operator>=(const BinaryAngle& other) const { return m_bam >= other.m_bam; }
+    friend BinaryAngle operator+(float rad, const BinaryAngle& other) { return from_bam(to_bam(rad) + other.m_bam); }
+    friend BinaryAngle operator-(float rad, const BinaryAngle& other) { return from_bam(to_bam(rad) - other.m_bam); }
+    friend BinaryAngle operator*(float factor, const BinaryAngle& other) { return other * factor; }
+    // Angle + BinaryAngle работает через перевод в Angle; обратный порядок
+    // даёт тот же тип, чтобы операнды можно было менять местами.
+    template <typename T>
+    friend BasicAngle<T> operator+(const BinaryAngle& angle, const BasicAngle<T>& other) { return BasicAngle<T>(angle) + other; }
+    template <typename T>
+    friend BasicAngle<T> operator-(const BinaryAngle& angle, const BasicAngle<T>& other) { return BasicAngle<T>(angle) - other; }
+};
+
+#endif
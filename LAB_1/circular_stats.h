@@ -0,0 +1,261 @@
+#ifndef CIRCULAR_STATS_H
+#define CIRCULAR_STATS_H
+#include <algorithm>
+#include <cmath>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "angle.h"
+
+
+// Круговая статистика массива углов: среднее направление, длина
+// результирующего вектора R (от 0 - углы разбросаны до 1 - все совпадают),
+// круговая дисперсия 1 - R и стандартное отклонение sqrt(-2 ln R).
+// Среднее арифметическое радиан здесь не годится: у 350 и 10 градусов
+// среднее направление 0, а не 180.
+//
+// Хранит суммы sin, cos и весов, поэтому результаты по частям массива
+// складываются через +=. Массив режется на куски фиксированного размера,
+// куски суммируются независимо (при threads != 1 - в нескольких потоках),
+// а их суммы складываются по порядку, так что результат побитово не зависит
+// от числа потоков.
+template <typename T>
+class BasicCircularStats {
+    using Angle = BasicAngle<T>;
+public:
+    using value_type = T;
+    using calc_type = typename Angle::calc_type;
+    static constexpr std::size_t chunk_size = 1 << 14;
+private:
+    static constexpr std::size_t block = 256;
+    // Независимые частичные суммы: цикл по ним векторизуется без
+    // перестановки сложений, и порядок задаёт код, а не компилятор.
+    static constexpr std::size_t lanes = 8;
+    calc_type m_sin = 0;
+    calc_type m_cos = 0;
+    calc_type m_weight = 0;
+
+    static BasicCircularStats chunk(const T* rad, const T* weights, std::size_t n, TrigAccuracy accuracy) {
+        calc_type s[lanes] = {}, c[lanes] = {}, w[lanes] = {};
+        T sin[block], cos[block];
+        for (std::size_t offset = 0; offset < n; offset += block) {
+            std::size_t m = std::min(block, n - offset);
+            Angle::sincos(std::span<const T>(rad + offset, m), sin, cos, accuracy);
+            std::size_t i = 0;
+            if (weights) {
+                const T* weight = weights + offset;
+                for (; i + lanes <= m; i += lanes) {
+                    for (std::size_t j = 0; j < lanes; ++j) {
+                        s[j] += calc_type(weight[i + j]) * sin[i + j];
+                        c[j] += calc_type(weight[i + j]) * cos[i + j];
+                        w[j] += weight[i + j];
+                    }
+                }
+                for (; i < m; ++i) {
+                    s[i % lanes] += calc_type(weight[i]) * sin[i];
+                    c[i % lanes] += calc_type(weight[i]) * cos[i];
+                    w[i % lanes] += weight[i];
+                }
+            }
+            else {
+                for (; i + lanes <= m; i += lanes) {
+                    for (std::size_t j = 0; j < lanes; ++j) {
+                        s[j] += sin[i + j];
+                        c[j] += cos[i + j];
+                    }
+                }
+                for (; i < m; ++i) {
+                    s[i % lanes] += sin[i];
+                    c[i % lanes] += cos[i];
+                }
+            }
+        }
+        BasicCircularStats result;
+        for (std::size_t j = 0; j < lanes; ++j) {
+            result.m_sin += s[j];
+            result.m_cos += c[j];
+            result.m_weight += w[j];
+        }
+        if (!weights) { result.m_weight = n; }
+        return result;
+    }
+    static BasicCircularStats reduce(std::span<const T> rad, const T* weights, TrigAccuracy accuracy, unsigned threads) {
+        std::size_t chunks = (rad.size() + chunk_size - 1) / chunk_size;
+        std::vector<BasicCircularStats> partial(chunks);
+        auto work = [&](std::size_t first, std::size_t step) {
+            for (std::size_t i = first; i < chunks; i += step) {
+                std::size_t offset = i * chunk_size;
+                partial[i] = chunk(rad.data() + offset, weights ? weights + offset : nullptr,
+                    std::min(chunk_size, rad.size() - offset), accuracy);
+            }
+        };
+        if (threads == 0) { threads = std::max(1u, std::thread::hardware_concurrency()); }
+        std::size_t workers = std::min<std::size_t>(threads, chunks);
+        if (workers <= 1) { work(0, 1); }
+        else {
+            std::vector<std::thread> pool;
+            pool.reserve(workers - 1);
+            for (std::size_t t = 1; t < workers; ++t) { pool.emplace_back(work, t, workers); }
+            work(0, workers);
+            for (std::thread& thread : pool) { thread.join(); }
+        }
+        BasicCircularStats result;
+        for (const BasicCircularStats& part : partial) { result += part; }
+        return result;
+    }
+public:
+    BasicCircularStats() {}
+    BasicCircularStats(calc_type sin_sum, calc_type cos_sum, calc_type weight):
+        m_sin(sin_sum), m_cos(cos_sum), m_weight(weight) {}
+    // threads = 0 - по числу ядер; потоков не больше, чем кусков по chunk_size.
+    static BasicCircularStats compute(std::span<const T> rad, TrigAccuracy accuracy = TrigAccuracy::exact,
+        unsigned threads = 0) {
+        return reduce(rad, nullptr, accuracy, threads);
+    }
+    static BasicCircularStats compute(std::span<const T> rad, std::span<const T> weights,
+        TrigAccuracy accuracy = TrigAccuracy::exact, unsigned threads = 0) {
+        if (weights.size() != rad.size()) { throw std::invalid_argument("Weights and angles differ in size"); }
+        return reduce(rad, weights.data(), accuracy, threads);
+    }
+    void add(const Angle& angle, T weight = 1) {
+        SinCos<T> v = angle.sincos();
+        m_sin += calc_type(weight) * v.sin;
+        m_cos += calc_type(weight) * v.cos;
+        m_weight += weight;
+    }
+    BasicCircularStats& operator+=(const BasicCircularStats& other) {
+        m_sin += other.m_sin;
+        m_cos += other.m_cos;
+        m_weight += other.m_weight;
+        return *this;
+    }
+    BasicCircularStats operator+(const BasicCircularStats& other) const { return BasicCircularStats(*this) += other; }
+
+    calc_type weight() const { return m_weight; }
+    calc_type sin_sum() const { return m_sin; }
+    calc_type cos_sum() const { return m_cos; }
+    // Для пустого набора и при R = 0 направление не определено - тогда 0.
+    Angle mean() const { return Angle::from_vector(T(m_cos), T(m_sin)); }
+    calc_type resultant_length() const {
+        if (m_weight <= 0) { return 0; }
+        return std::min(calc_type(1), std::hypot(m_sin, m_cos) / m_weight);
+    }
+    calc_type variance() const { return 1 - resultant_length(); }
+    // При R = 0 отклонение бесконечно.
+    calc_type std_dev() const { return std::sqrt(std::max(calc_type(0), -2 * std::log(resultant_length()))); }
+};
+
+namespace detail {
+    // Компенсированная сумма: потерянные при сложении младшие биты, найденные
+    // через two_sum без ветвлений, копятся в m_error.
+    template <typename T>
+    class CompensatedSum {
+        T m_sum = 0;
+        T m_error = 0;
+    public:
+        void add(T x) {
+            T error;
+            m_sum = two_sum(m_sum, x, error);
+            m_error += error;
+        }
+        T value() const { return m_sum + m_error; }
+        void reset() { m_sum = m_error = 0; }
+    };
+}
+
+// Статистика последних capacity углов потока. sin и cos каждого угла
+// считаются один раз при push и хранятся в кольцевом буфере, так что
+// вытеснение старого угла - вычитание без тригонометрии и push стоит O(1).
+// Суммы компенсированные, а раз в resum_period оборотов буфера они
+// пересчитываются по окну заново, чтобы ошибка не копилась на долгих потоках.
+template <typename T>
+class BasicCircularWindow {
+    using Angle = BasicAngle<T>;
+    using Stats = BasicCircularStats<T>;
+    using calc_type = typename Stats::calc_type;
+    static constexpr std::size_t block = 256;
+    std::vector<SinCos<T>> m_values;
+    std::size_t m_first = 0;
+    std::size_t m_size = 0;
+    std::size_t m_pushes = 0;
+    TrigAccuracy m_accuracy;
+    detail::CompensatedSum<calc_type> m_sin;
+    detail::CompensatedSum<calc_type> m_cos;
+
+    // В полном окне новый угол занимает место старого, и в суммы идёт одна
+    // разность вместо вычитания и сложения: цепочка зависимостей вдвое короче.
+    void push_value(SinCos<T> v) {
+        if (m_size == m_values.size()) {
+            SinCos<T> old = m_values[m_first];
+            m_values[m_first] = v;
+            m_first = m_first + 1 == m_values.size() ? 0 : m_first + 1;
+            m_sin.add(calc_type(v.sin) - old.sin);
+            m_cos.add(calc_type(v.cos) - old.cos);
+        }
+        else {
+            std::size_t last = m_first + m_size;
+            m_values[last < m_values.size() ? last : last - m_values.size()] = v;
+            ++m_size;
+            m_sin.add(v.sin);
+            m_cos.add(v.cos);
+        }
+        if (++m_pushes == resum_period * m_values.size()) { resum(); }
+    }
+public:
+    using value_type = T;
+    static constexpr std::size_t resum_period = 64;
+    explicit BasicCircularWindow(std::size_t capacity, TrigAccuracy accuracy = TrigAccuracy::exact):
+        m_values(capacity), m_accuracy(accuracy) {
+        if (capacity == 0) { throw std::invalid_argument("Window capacity must be positive"); }
+    }
+    std::size_t size() const { return m_size; }
+    std::size_t capacity() const { return m_values.size(); }
+    bool empty() const { return m_size == 0; }
+    bool full() const { return m_size == m_values.size(); }
+    void clear() {
+        m_first = m_size = m_pushes = 0;
+        m_sin.reset();
+        m_cos.reset();
+    }
+    // Если окно заполнено, самый старый угол вытесняется.
+    void push(const Angle& angle) { push_value(angle.sincos(m_accuracy)); }
+    // sin и cos всей пачки считаются пакетно, остальное - как push по одному.
+    void push(std::span<const T> rad) {
+        T sin[block], cos[block];
+        for (std::size_t offset = 0; offset < rad.size(); offset += block) {
+            std::size_t n = std::min(block, rad.size() - offset);
+            Angle::sincos(rad.subspan(offset, n), sin, cos, m_accuracy);
+            for (std::size_t i = 0; i < n; ++i) { push_value({sin[i], cos[i]}); }
+        }
+    }
+    void pop() {
+        if (m_size == 0) { throw std::out_of_range("Window is empty"); }
+        SinCos<T> v = m_values[m_first];
+        m_sin.add(-calc_type(v.sin));
+        m_cos.add(-calc_type(v.cos));
+        m_first = m_first + 1 == m_values.size() ? 0 : m_first + 1;
+        --m_size;
+    }
+    void resum() {
+        m_sin.reset();
+        m_cos.reset();
+        for (std::size_t i = 0; i < m_size; ++i) {
+            std::size_t index = m_first + i;
+            SinCos<T> v = m_values[index < m_values.size() ? index : index - m_values.size()];
+            m_sin.add(v.sin);
+            m_cos.add(v.cos);
+        }
+        m_pushes = 0;
+    }
+    Stats stats() const { return Stats(m_sin.value(), m_cos.value(), calc_type(m_size)); }
+    Angle mean() const { return stats().mean(); }
+    calc_type resultant_length() const { return stats().resultant_length(); }
+    calc_type variance() const { return stats().variance(); }
+    calc_type std_dev() const { return stats().std_dev(); }
+};
+
+using CircularStats = BasicCircularStats<float>;
+using CircularWindow = BasicCircularWindow<float>;
+
+#endif
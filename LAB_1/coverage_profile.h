@@ -0,0 +1,117 @@
+#ifndef COVERAGE_PROFILE_H
+#define COVERAGE_PROFILE_H
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "angle.h"
+
+
+// Сколько дуг покрывает каждое направление. Дуги разбиваются на
+// полуинтервалы границ, как в AngleRangeSet, и проход по отсортированным
+// началам и концам за O(n log n) даёт кусочно-постоянную глубину покрытия:
+// окружность целиком нарезана на куски [lo, hi) с одной глубиной в каждом,
+// соседние куски различаются глубиной. Включённость концов учитывается
+// точно: глубина в точке конца та же, что даёт подсчёт contains.
+template <typename T>
+class BasicCoverageProfile {
+    using Angle = BasicAngle<T>;
+    using AngleRange = BasicAngleRange<T>;
+    using Bound = detail::ArcBound<T>;
+    using Interval = detail::ArcInterval<T>;
+public:
+    using value_type = T;
+    using calc_type = typename Angle::calc_type;
+    struct Piece {
+        Interval part;
+        uint32_t depth;
+    };
+private:
+    std::vector<Piece> m_pieces;
+    uint32_t m_max_depth = 0;
+
+    struct Event {
+        Bound at;
+        int32_t delta;
+    };
+public:
+    BasicCoverageProfile(): m_pieces{Piece{Interval::circle(), 0}} {}
+    explicit BasicCoverageProfile(std::span<const AngleRange> ranges) {
+        if (ranges.size() > std::numeric_limits<int32_t>::max()) { throw std::invalid_argument("Too many ranges for a profile"); }
+        std::vector<Event> events;
+        events.reserve(4 * ranges.size());
+        for (const AngleRange& range : ranges) {
+            Interval pieces[2];
+            std::size_t count = range.to_intervals(pieces);
+            for (std::size_t i = 0; i < count; ++i) {
+                events.push_back(Event{pieces[i].lo, 1});
+                events.push_back(Event{pieces[i].hi, -1});
+            }
+        }
+        std::sort(events.begin(), events.end(), [](const Event& a, const Event& b) { return a.at < b.at; });
+        // Все изменения в одной границе применяются вместе; кусок с той же
+        // глубиной, что и предыдущий, продлевает его.
+        Bound position = Bound::begin();
+        int32_t depth = 0;
+        for (std::size_t i = 0; i < events.size();) {
+            Bound at = events[i].at;
+            int32_t next = depth;
+            for (; i < events.size() && events[i].at == at; ++i) { next += events[i].delta; }
+            if (next == depth) { continue; }
+            if (position < at) { m_pieces.push_back(Piece{Interval{position, at}, static_cast<uint32_t>(depth)}); }
+            position = at;
+            depth = next;
+        }
+        if (position < Bound::end()) { m_pieces.push_back(Piece{Interval{position, Bound::end()}, static_cast<uint32_t>(depth)}); }
+        for (const Piece& piece : m_pieces) {
+            T point;
+            if (detail::first_angle(piece.part, point)) { m_max_depth = std::max(m_max_depth, piece.depth); }
+        }
+    }
+    // Куски по возрастанию, от begin до end окружности без пропусков.
+    std::span<const Piece> pieces() const { return m_pieces; }
+    uint32_t max_depth() const { return m_max_depth; }
+    // Число дуг, содержащих угол, за O(log n).
+    uint32_t depth(const Angle& angle) const {
+        T rad = Angle::normalize(angle.getRadians());
+        if (rad != rad) { return 0; }
+        Bound at{rad, false};
+        auto it = std::upper_bound(m_pieces.begin(), m_pieces.end(), at,
+            [](const Bound& value, const Piece& piece) { return value < piece.part.lo; });
+        return it == m_pieces.begin() ? 0 : (it - 1)->depth;
+    }
+    // Дуги, покрытые не менее чем min_depth раз; касающиеся куски сливаются.
+    std::vector<AngleRange> covered(uint32_t min_depth) const {
+        std::vector<Interval> parts;
+        for (const Piece& piece : m_pieces) {
+            if (piece.depth < min_depth) { continue; }
+            if (!parts.empty() && parts.back().hi == piece.part.lo) { parts.back().hi = piece.part.hi; }
+            else { parts.push_back(piece.part); }
+        }
+        std::vector<AngleRange> result;
+        AngleRange::from_intervals(parts.data(), parts.size(), result);
+        return result;
+    }
+    // Дуги наибольшего покрытия; пусто, если дуг не было. Наибольшая глубина
+    // считается только по кускам, где есть углы.
+    std::vector<AngleRange> max_ranges() const {
+        if (m_max_depth == 0) { return {}; }
+        return covered(m_max_depth);
+    }
+    // Суммарная длина направлений, покрытых не менее чем min_depth раз.
+    calc_type length(uint32_t min_depth) const {
+        calc_type total = 0;
+        for (const Piece& piece : m_pieces) {
+            if (piece.depth < min_depth) { continue; }
+            calc_type hi = piece.part.hi == Bound::end() ? 2 * Angle::pi : calc_type(piece.part.hi.rad);
+            total += hi - piece.part.lo.rad;
+        }
+        return total;
+    }
+};
+
+using CoverageProfile = BasicCoverageProfile<float>;
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef PACKED_ANGLE_RANGE_H
+#define PACKED_ANGLE_RANGE_H
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include "angle.h"
+
+
+// Дуга в двух числах T (8 байт для float) вместо 12 у AngleRange. Концы
+// хранятся приведёнными к [0, 2pi), поэтому знаковый бит у них свободен и
+// занят флагом включения конца. Полная окружность кодируется концом,
+// равным бесконечности. Принадлежность и длина совпадают с AngleRange,
+// из которой дуга получена.
+template <typename T>
+class BasicPackedAngleRange {
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>, "Packed ranges need IEEE float or double");
+    using Angle = BasicAngle<T>;
+    using NormalizedAngle = BasicNormalizedAngle<T>;
+    using AngleRange = BasicAngleRange<T>;
+    using bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+    static constexpr bits sign = bits(1) << (8 * sizeof(T) - 1);
+    static constexpr T infinity = std::numeric_limits<T>::infinity();
+    T m_start;
+    T m_end;
+
+    static constexpr T pack(T rad, bool flag) {
+        return std::bit_cast<T>((std::bit_cast<bits>(rad) & ~sign) | (flag ? sign : 0));
+    }
+    // fabs и signbit векторизуются, а bit_cast - нет; он нужен только в constexpr.
+    static constexpr T value(T field) {
+        return std::is_constant_evaluated() ? std::bit_cast<T>(std::bit_cast<bits>(field) & ~sign) : std::fabs(field);
+    }
+    static constexpr bool flag(T field) {
+        return std::is_constant_evaluated() ? (std::bit_cast<bits>(field) & sign) != 0 : std::signbit(field);
+    }
+    // Та же проверка, что в AngleRange::contains_normalized, без ветвлений,
+    // чтобы цикл по массиву дуг векторизовался.
+    static constexpr bool test(T start_field, T end_field, T rad) {
+        T start = value(start_field), end = value(end_field);
+        bool in_start = flag(start_field), in_end = flag(end_field);
+        bool left_ok = (in_start & !(rad < start)) | (!in_start & (rad > start));
+        bool right_ok = (in_end & !(rad > end)) | (!in_end & (rad < end));
+        bool wraps = !(start <= end), is_full = end == infinity;
+        bool arc = (left_ok & right_ok) | (wraps & (left_ok | right_ok));
+        bool full = (rad != start) | in_start | in_end;
+        return (is_full & full) | (!is_full & arc);
+    }
+public:
+    using value_type = T;
+    using calc_type = typename Angle::calc_type;
+    constexpr BasicPackedAngleRange(const AngleRange& range):
+        m_start(pack(Angle::normalize(range.getStart().getRadians()), range.includesStart())),
+        m_end(pack(range.is_full() ? infinity : Angle::normalize(range.getEnd().getRadians()), range.includesEnd())) {}
+    operator AngleRange() const {
+        if (is_full()) { return AngleRange::full(getStart(), includesStart(), includesEnd()); }
+        return AngleRange(value(m_start), value(m_end), includesStart(), includesEnd());
+    }
+    // Для полной окружности getEnd совпадает с getStart.
+    constexpr Angle getStart() const { return Angle(value(m_start)); }
+    constexpr Angle getEnd() const { return Angle(is_full() ? value(m_start) : value(m_end)); }
+    constexpr bool includesStart() const { return flag(m_start); }
+    constexpr bool includesEnd() const { return flag(m_end); }
+    constexpr bool is_full() const { return value(m_end) == infinity; }
+    constexpr calc_type length() const {
+        if (is_full()) { return 2 * Angle::pi; }
+        calc_type len = calc_type(value(m_end)) - value(m_start);
+        if (len < 0) { len += 2 * Angle::pi; }
+        return len;
+    }
+    constexpr bool operator==(const BasicPackedAngleRange& other) const {
+        return std::bit_cast<bits>(m_start) == std::bit_cast<bits>(other.m_start)
+            && std::bit_cast<bits>(m_end) == std::bit_cast<bits>(other.m_end);
+    }
+    constexpr bool operator!=(const BasicPackedAngleRange& other) const { return !(*this == other); }
+    constexpr bool contains(const Angle& other) const { return test(m_start, m_end, Angle::normalize(other.getRadians())); }
+    constexpr bool contains(const NormalizedAngle& other) const { return test(m_start, m_end, other.getRadians()); }
+    // Какие из дуг содержат угол: mask[i] = ranges[i].contains(angle).
+    static void contains(std::span<const BasicPackedAngleRange> ranges, const Angle& angle, std::span<uint8_t> mask) {
+        if (mask.size() < ranges.size()) { throw std::invalid_argument("Mask is too small"); }
+        T rad = Angle::normalize(angle.getRadians());
+        const BasicPackedAngleRange* in = ranges.data();
+        uint8_t* out = mask.data();
+        for (std::size_t i = 0; i < ranges.size(); ++i) { out[i] = test(in[i].m_start, in[i].m_end, rad); }
+    }
+};
+
+using PackedAngleRange = BasicPackedAngleRange<float>;
+static_assert(sizeof(PackedAngleRange) == 8 && std::is_trivially_copyable_v<PackedAngleRange>);
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef ROTATION_H
+#define ROTATION_H
+#include <span>
+#include <stdexcept>
+#include "angle.h"
+
+
+// Поворот плоскости на угол: sin и cos считаются один раз при построении,
+// дальше поворот точек - только умножения. Композиция складывает углы и
+// перемножает уже посчитанные sin и cos по формулам суммы, без новых
+// вызовов тригонометрии.
+template <typename T>
+class BasicRotation2D {
+    using Angle = BasicAngle<T>;
+    using calc_type = typename Angle::calc_type;
+    // Угол в [0, 2pi) хранится в calc_type: в T при каждой композиции
+    // терялось бы по округлению, и за сотни тысяч шагов угол уходил бы от sin и cos.
+    calc_type m_rad;
+    T m_sin;
+    T m_cos;
+
+    constexpr BasicRotation2D(calc_type rad, T sin, T cos): m_rad(rad), m_sin(sin), m_cos(cos) {}
+    // Сумма углов из [0, 2pi) лежит в [0, 4pi), и для приведения хватает
+    // одного вычитания вместо fmod.
+    static constexpr calc_type wrap(calc_type rad) { return rad >= 2 * Angle::pi ? rad - 2 * Angle::pi : rad; }
+public:
+    using value_type = T;
+    constexpr BasicRotation2D(): m_rad(0), m_sin(0), m_cos(1) {}
+    explicit BasicRotation2D(const Angle& angle, TrigAccuracy accuracy = TrigAccuracy::exact):
+        m_rad(Angle::normalize(angle.getRadians())) {
+        SinCos<T> v = angle.sincos(accuracy);
+        m_sin = v.sin;
+        m_cos = v.cos;
+    }
+    static constexpr BasicRotation2D identity() { return BasicRotation2D(); }
+    // Угол поворота, приведённый к [0, 2pi).
+    constexpr Angle angle() const { return Angle(Angle::normalize(static_cast<T>(m_rad))); }
+    constexpr T sin() const { return m_sin; }
+    constexpr T cos() const { return m_cos; }
+
+    // Обратный поворот точен: меняется только знак синуса.
+    constexpr BasicRotation2D inverse() const { return BasicRotation2D(wrap(2 * Angle::pi - m_rad), -m_sin, m_cos); }
+    // Ошибка округления в формулах суммы накапливается в длине (cos, sin),
+    // поэтому результат подтягивается к единичной окружности шагом Ньютона
+    // для 1 / sqrt - без деления и корня. Направление (cos, sin) при этом
+    // может отходить от точного на ошибку округления T за шаг; угол в
+    // calc_type складывается почти точно.
+    constexpr BasicRotation2D operator+(const BasicRotation2D& other) const {
+        T sin = m_sin * other.m_cos + m_cos * other.m_sin;
+        T cos = m_cos * other.m_cos - m_sin * other.m_sin;
+        T scale = (3 - (sin * sin + cos * cos)) / 2;
+        return BasicRotation2D(wrap(m_rad + other.m_rad), sin * scale, cos * scale);
+    }
+    constexpr BasicRotation2D operator-(const BasicRotation2D& other) const { return *this + other.inverse(); }
+    constexpr BasicRotation2D& operator+=(const BasicRotation2D& other) { return *this = *this + other; }
+    constexpr BasicRotation2D& operator-=(const BasicRotation2D& other) { return *this = *this - other; }
+
+    constexpr void apply(T& x, T& y) const {
+        T px = x, py = y;
+        x = m_cos * px - m_sin * py;
+        y = m_sin * px + m_cos * py;
+    }
+    // Точки хранятся столбцами. Выход может совпадать со входом.
+    void apply(std::span<const T> x, std::span<const T> y, std::span<T> out_x, std::span<T> out_y) const {
+        if (y.size() != x.size()) { throw std::invalid_argument("Coordinate arrays differ in size"); }
+        if (out_x.size() < x.size() || out_y.size() < x.size()) { throw std::invalid_argument("Output is too small"); }
+        const T* px = x.data();
+        const T* py = y.data();
+        T* ox = out_x.data();
+        T* oy = out_y.data();
+        T sin = m_sin, cos = m_cos;
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            T a = px[i], b = py[i];
+            ox[i] = cos * a - sin * b;
+            oy[i] = sin * a + cos * b;
+        }
+    }
+    void apply(std::span<T> x, std::span<T> y) const { apply(x, y, x, y); }
+};
+
+using Rotation2D = BasicRotation2D<float>;
+
+#endif
@@ -0,0 +1,153 @@
+#ifndef SECTOR_CLASSIFIER_H
+#define SECTOR_CLASSIFIER_H
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "angle.h"
+
+
+// Номер сектора для угла, если секторы - непересекающиеся дуги. Окружность
+// разбита на 2^k равных ячеек, и ячейка находится по индексу rad * scale.
+// Почти в каждой ячейке не больше одной границы, поэтому ячейка хранит эту
+// границу и номера секторов до и после неё: номер выбирается одним
+// сравнением без ветвления. Только для ячеек с несколькими границами идёт
+// двоичный поиск среди границ этой ячейки. Концы секторов учитываются так
+// же, как в contains: границы хранятся в виде ArcBound.
+template <typename T>
+class BasicSectorClassifier {
+    using Angle = BasicAngle<T>;
+    using AngleRange = BasicAngleRange<T>;
+    using Bound = detail::ArcBound<T>;
+    using Interval = detail::ArcInterval<T>;
+    using calc_type = typename Angle::calc_type;
+    static constexpr std::size_t block = detail::normalize_block_size;
+    static constexpr uint32_t straddle = uint32_t(1) << 31;
+
+    // Граница split; below - номер до неё или straddle | номер записи в m_ranges.
+    struct Cell {
+        Bound split;
+        uint32_t below;
+        uint32_t above;
+    };
+    // Для ячеек с несколькими границами: куски m_ranges[i].first .. m_ranges[i].last.
+    struct CellRange {
+        uint32_t first;
+        uint32_t last;
+    };
+    // Куски окружности [m_bounds[j], m_bounds[j + 1]) с номером сектора m_labels[j].
+    std::vector<Bound> m_bounds;
+    std::vector<uint32_t> m_labels;
+    std::vector<Cell> m_cells;
+    std::vector<CellRange> m_ranges;
+    T m_scale = 0;
+    uint32_t m_last_cell = 0;
+    std::size_t m_size = 0;
+
+    // Последний кусок с началом не позже bound.
+    std::size_t piece(std::size_t first, std::size_t last, const Bound& bound) const {
+        auto it = std::upper_bound(m_bounds.begin() + first, m_bounds.begin() + last, bound);
+        return it - m_bounds.begin() - 1;
+    }
+    // Ячеек не больше 2^20, так что хватает быстрого перевода в int32.
+    uint32_t cell_index(T rad) const {
+        return std::min(static_cast<uint32_t>(static_cast<int32_t>(rad * m_scale)), m_last_cell);
+    }
+    uint32_t resolve(T rad, const Cell& cell) const {
+        bool before = (rad < cell.split.rad) | ((rad == cell.split.rad) & cell.split.after);
+        uint32_t value = cell.above + (cell.below - cell.above) * before;
+        if (!(value & straddle)) { return value; }
+        const CellRange& range = m_ranges[value & ~straddle];
+        return m_labels[piece(range.first, range.last + 1, Bound{rad, false})];
+    }
+public:
+    using value_type = T;
+    static constexpr uint32_t none = straddle - 1;
+    BasicSectorClassifier() {}
+    // Номер сектора - его позиция в sectors. Касаться секторы могут, пересекаться - нет.
+    explicit BasicSectorClassifier(std::span<const AngleRange> sectors): m_size(sectors.size()) {
+        if (sectors.size() >= none) { throw std::invalid_argument("Too many sectors"); }
+        struct Part {
+            Interval interval;
+            uint32_t id;
+        };
+        std::vector<Part> parts;
+        for (std::size_t i = 0; i < sectors.size(); ++i) {
+            Interval pieces[2];
+            std::size_t count = sectors[i].to_intervals(pieces);
+            for (std::size_t j = 0; j < count; ++j) { parts.push_back(Part{pieces[j], static_cast<uint32_t>(i)}); }
+        }
+        std::sort(parts.begin(), parts.end(), [](const Part& a, const Part& b) { return a.interval.lo < b.interval.lo; });
+        Bound position = Bound::begin();
+        for (const Part& part : parts) {
+            if (part.interval.lo < position) { throw std::invalid_argument("Sectors overlap"); }
+            if (position < part.interval.lo) {
+                m_bounds.push_back(position);
+                m_labels.push_back(none);
+            }
+            m_bounds.push_back(part.interval.lo);
+            m_labels.push_back(part.id);
+            position = part.interval.hi;
+        }
+        if (position < Bound::end()) {
+            m_bounds.push_back(position);
+            m_labels.push_back(none);
+        }
+
+        // Ячеек в несколько раз больше, чем границ, чтобы две границы в одной
+        // ячейке встречались редко.
+        std::size_t cells = std::bit_ceil(std::clamp<std::size_t>(8 * m_bounds.size(), 256, std::size_t(1) << 20));
+        m_cells.resize(cells);
+        m_last_cell = static_cast<uint32_t>(cells - 1);
+        m_scale = static_cast<T>(cells / (2 * Angle::pi));
+        // Индекс rad * scale считается в T и у краёв ячейки может сбиться на
+        // единицу, поэтому ячейка проверяется с запасом, покрывающим ошибку
+        // округления, но не меньше 1/16 ячейки.
+        calc_type margin = std::max(calc_type(1) / 16, 4 * cells * calc_type(std::numeric_limits<T>::epsilon()));
+        for (std::size_t cell = 0; cell < cells; ++cell) {
+            T lo = static_cast<T>(std::max(calc_type(0), (cell - margin) / m_scale));
+            T hi = static_cast<T>((cell + 1 + margin) / m_scale);
+            std::size_t first = piece(0, m_bounds.size(), Bound{lo, false});
+            std::size_t last = piece(first, m_bounds.size(), Bound{hi, false});
+            if (first == last) { m_cells[cell] = Cell{Bound::end(), m_labels[first], m_labels[first]}; }
+            else if (first + 1 == last) { m_cells[cell] = Cell{m_bounds[last], m_labels[first], m_labels[last]}; }
+            else {
+                uint32_t range = straddle | static_cast<uint32_t>(m_ranges.size());
+                m_cells[cell] = Cell{Bound::end(), range, range};
+                m_ranges.push_back(CellRange{static_cast<uint32_t>(first), static_cast<uint32_t>(last)});
+            }
+        }
+    }
+    std::size_t size() const { return m_size; }
+    // Номер сектора, содержащего угол, или none.
+    uint32_t classify(const Angle& angle) const {
+        if (m_cells.empty()) { return none; }
+        T rad = Angle::normalize(angle.getRadians());
+        return resolve(rad, m_cells[cell_index(rad)]);
+    }
+    void classify(std::span<const T> rad, std::span<uint32_t> out) const {
+        if (out.size() < rad.size()) { throw std::invalid_argument("Output is too small"); }
+        if (m_cells.empty()) {
+            std::fill(out.begin(), out.begin() + rad.size(), none);
+            return;
+        }
+        // Индексы ячеек считаются отдельным векторизуемым проходом.
+        T tmp[block];
+        uint32_t index[block];
+        const Cell* cells = m_cells.data();
+        for (std::size_t offset = 0; offset < rad.size(); offset += block) {
+            std::size_t n = std::min(block, rad.size() - offset);
+            detail::normalize_block(rad.data() + offset, tmp, n);
+            for (std::size_t i = 0; i < n; ++i) { index[i] = cell_index(tmp[i]); }
+            uint32_t* result = out.data() + offset;
+            for (std::size_t i = 0; i < n; ++i) { result[i] = resolve(tmp[i], cells[index[i]]); }
+        }
+    }
+};
+
+using SectorClassifier = BasicSectorClassifier<float>;
+
+#endif
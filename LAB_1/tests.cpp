@@ -0,0 +1,928 @@
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "angle.h"
+#include "angle_buffer.h"
+#include "angle_file.h"
+#include "angle_range_index.h"
+#include "angle_range_set.h"
+#include "binary_angle.h"
+#include "circular_stats.h"
+#include "coverage_profile.h"
+#include "packed_angle_range.h"
+#include "rotation.h"
+#include "sector_classifier.h"
+
+
+// Проверки работают и в Release, где assert отключён: ошибки считаются,
+// первые из них печатаются, код возврата ненулевой.
+int failures = 0;
+
+void check(bool ok, const char* what, int line) {
+    if (ok) { return; }
+    if (++failures <= 20) { std::fprintf(stderr, "tests.cpp:%d: %s\n", line, what); }
+}
+#define CHECK(expr) check((expr), #expr, __LINE__)
+
+const float two_pi = std::nextafter(static_cast<float>(2 * M_PI), 0.0f);
+
+float next_up(float x) { return std::nextafter(x, std::numeric_limits<float>::infinity()); }
+float next_down(float x) { return std::nextafter(x, -std::numeric_limits<float>::infinity()); }
+
+// Принадлежность угла из [0, 2pi) дуге по определению: идём от start против
+// часовой стрелки и смотрим, встретится ли x раньше end. Разности считаются
+// в double, где разность двух float точна.
+bool brute_contains(const AngleRange& range, float x) {
+    float start = Angle::normalize(range.getStart().getRadians());
+    if (range.is_full()) { return x != start || range.includesStart() || range.includesEnd(); }
+    float end = Angle::normalize(range.getEnd().getRadians());
+    if (x == start && x == end) { return range.includesStart() && range.includesEnd(); }
+    if (x == start) { return range.includesStart(); }
+    if (x == end) { return range.includesEnd(); }
+    double to_x = double(x) - start, to_end = double(end) - start;
+    if (to_x < 0) { to_x += 2 * M_PI; }
+    if (to_end < 0) { to_end += 2 * M_PI; }
+    return to_x < to_end;
+}
+
+// Случайная дуга: концы то из набора особых значений (0, pi, около 2pi,
+// за пределами [0, 2pi)), то случайные; ширина от нуля до больше оборота;
+// все четыре сочетания флагов; часть дуг - AngleRange::full.
+struct RangeGenerator {
+    std::mt19937 gen;
+    explicit RangeGenerator(unsigned seed): gen(seed) {}
+    float uniform(float lo, float hi) { return std::uniform_real_distribution<float>(lo, hi)(gen); }
+    float special() {
+        const float values[] = {0, 1, float(M_PI), 4, two_pi, float(2 * M_PI), -1, float(-M_PI), 7, 10};
+        return values[gen() % std::size(values)];
+    }
+    AngleRange operator()() {
+        bool in_start = gen() % 2, in_end = gen() % 2;
+        float start = gen() % 3 == 0 ? special() : uniform(-7, 14);
+        switch (gen() % 8) {
+            case 0: return AngleRange::full(Angle(start), in_start, in_end);
+            case 1: return AngleRange(start, start, in_start, in_end);
+            case 2: return AngleRange(start, special(), in_start, in_end);
+            case 3: return AngleRange(start, start + uniform(6.5f, 9), in_start, in_end);
+            default: return AngleRange(start, start + uniform(1e-3f, 6.2f), in_start, in_end);
+        }
+    }
+};
+
+// Точки проверки: концы дуг и соседние с ними числа, края [0, 2pi) и
+// случайные углы. Любой непустой кусок разности двух дуг содержит одну из них.
+std::vector<float> probes(std::initializer_list<AngleRange> ranges, std::mt19937& gen) {
+    std::vector<float> result = {0, next_up(0), two_pi, next_down(two_pi)};
+    for (const AngleRange& range : ranges) {
+        for (float rad : {range.getStart().getRadians(), range.getEnd().getRadians()}) {
+            float x = Angle::normalize(rad);
+            for (float p : {x, next_up(x), next_down(x)}) {
+                if (p >= 0 && p <= two_pi) { result.push_back(p); }
+            }
+        }
+    }
+    for (int i = 0; i < 16; ++i) { result.push_back(std::uniform_real_distribution<float>(0, two_pi)(gen)); }
+    return result;
+}
+
+// Приведение к [0, 2pi) против long double: результат строго меньше 2pi и
+// отстоит от точного не больше чем на ошибку округления; пакетный путь
+// совпадает с поштучным.
+void test_normalize() {
+    std::mt19937 gen(5);
+    std::vector<float> rad = {0, -0.0f, -1e-9f, -1e-30f, two_pi, float(2 * M_PI), -float(2 * M_PI), 1e30f, -1e30f};
+    for (int i = 0; i < 4096; ++i) {
+        float scale = std::ldexp(1.0f, int(gen() % 40) - 20);
+        rad.push_back(std::uniform_real_distribution<float>(-scale, scale)(gen));
+    }
+    std::vector<float> batch(rad.size());
+    for (std::size_t offset = 0; offset < rad.size(); offset += detail::normalize_block_size) {
+        std::size_t n = std::min(detail::normalize_block_size, rad.size() - offset);
+        detail::normalize_block(rad.data() + offset, batch.data() + offset, n);
+    }
+    for (std::size_t i = 0; i < rad.size(); ++i) {
+        float x = Angle::normalize(rad[i]);
+        CHECK(x >= 0 && x <= two_pi);
+        CHECK(batch[i] == x);
+        // Период - 2pi в calc_type, как в normalize: для больших x это важно.
+        long double period = 2 * Angle::pi;
+        long double exact = std::fmod((long double)rad[i], period);
+        if (exact < 0) { exact += period; }
+        long double error = std::fabs(exact - x);
+        CHECK(std::min(error, period - error) <= 4e-7L);
+    }
+}
+
+// Расстояние между углами по окружности.
+double circle_distance(double a, double b) {
+    double d = std::fmod(std::fabs(a - b), 2 * M_PI);
+    return std::min(d, 2 * M_PI - d);
+}
+
+// from_vector во всех режимах даёт угол из [0, 2pi) без -0, близкий к
+// atan2 в long double; пакетный вызов совпадает с поштучным.
+void test_from_vector() {
+    std::mt19937 gen(6);
+    std::vector<float> x = {1, 1, 1, -1, -1, 0, 0, -0.0f, 1e-30f, -1e-30f, 1};
+    std::vector<float> y = {-0.0f, -1e-30f, 1e-30f, -0.0f, 0, 0, -1, -0.0f, -1, 1, -1e-7f};
+    for (int i = 0; i < 4096; ++i) {
+        float scale = std::ldexp(1.0f, int(gen() % 60) - 30);
+        x.push_back(std::uniform_real_distribution<float>(-scale, scale)(gen));
+        y.push_back(std::uniform_real_distribution<float>(-scale, scale)(gen) * (gen() % 4 ? 1 : 1e-6f));
+    }
+    for (TrigAccuracy accuracy : {TrigAccuracy::exact, TrigAccuracy::fast, TrigAccuracy::table}) {
+        std::vector<float> batch(x.size());
+        Angle::from_vector(x, y, batch, accuracy);
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            float rad = Angle::from_vector(x[i], y[i], accuracy).getRadians();
+            CHECK(rad >= 0 && rad <= two_pi && !std::signbit(rad));
+            CHECK(batch[i] == rad);
+            // У нулевого вектора направления нет, и режимы вправе расходиться.
+            if (x[i] == 0 && y[i] == 0) { continue; }
+            double expected = std::atan2((long double)y[i], (long double)x[i]);
+            CHECK(circle_distance(rad, expected) <= (accuracy == TrigAccuracy::exact ? 5e-7 : 1e-6));
+        }
+    }
+}
+
+// Угол композиции долго не уходит от точной суммы углов, а (cos, sin)
+// отходит от неё не больше чем на накопленную ошибку округления float.
+void test_rotation() {
+    const int steps = 360000;
+    Rotation2D step(Angle::from_degrees(1)), total;
+    for (int i = 0; i < steps; ++i) { total += step; }
+    double expected = std::fmod(steps * double(Angle::from_degrees(1).getRadians()), 2 * M_PI);
+    CHECK(circle_distance(total.angle().getRadians(), expected) < 1e-6);
+    CHECK(circle_distance(std::atan2(double(total.sin()), double(total.cos())), expected) < 1e-4);
+    Rotation2D back;
+    for (int i = 0; i < 1000; ++i) { back -= Rotation2D(Angle(0.37f)); }
+    CHECK(circle_distance(back.angle().getRadians(), -1000 * double(0.37f)) < 1e-6);
+    CHECK(total.angle().getRadians() >= 0 && back.angle().getRadians() >= 0);
+}
+
+template <typename Pieces>
+bool pieces_contain(const Pieces& pieces, float x) {
+    bool result = false;
+    for (const AngleRange& piece : pieces) { result |= piece.contains(Angle(x)); }
+    return result;
+}
+
+void test_range_contains() {
+    RangeGenerator next(1);
+    for (int i = 0; i < 20000; ++i) {
+        AngleRange range = next();
+        for (float x : probes({range}, next.gen)) {
+            CHECK(range.contains(Angle(x)) == brute_contains(range, x));
+            CHECK(range.contains(NormalizedAngle(Angle(x))) == brute_contains(range, x));
+        }
+    }
+}
+
+// Длина против доли равномерной сетки точек, попавших в дугу: каждая
+// граница сдвигает счёт не больше чем на одну точку.
+void test_range_length() {
+    RangeGenerator next(2);
+    const int grid = 1 << 12;
+    for (int i = 0; i < 2000; ++i) {
+        AngleRange range = next();
+        float shift = next.uniform(0, 1);
+        int inside = 0;
+        for (int k = 0; k < grid; ++k) { inside += brute_contains(range, float((k + shift) * 2 * M_PI / grid)); }
+        double expected = inside * 2 * M_PI / grid;
+        CHECK(std::fabs(range.length() - expected) <= 2 * 2 * M_PI / grid + 1e-5);
+    }
+}
+
+void test_range_operators() {
+    RangeGenerator next(3);
+    for (int i = 0; i < 20000; ++i) {
+        AngleRange a = next(), b = next();
+        AngleRange::Pieces sum = a + b, difference = a - b, common = a & b;
+        CHECK(sum.size() <= 2 && difference.size() <= 2 && common.size() <= 2);
+        CHECK(a.intersect(b).size() == common.size());
+        bool inside = true;
+        for (float x : probes({a, b}, next.gen)) {
+            bool in_a = brute_contains(a, x), in_b = brute_contains(b, x);
+            CHECK(pieces_contain(sum, x) == (in_a || in_b));
+            CHECK(pieces_contain(difference, x) == (in_a && !in_b));
+            CHECK(pieces_contain(common, x) == (in_a && in_b));
+            inside &= !in_b || in_a;
+        }
+        CHECK(a.contains(b) == inside);
+    }
+}
+
+// Сравнение дуг доступно и в константных выражениях.
+static_assert(AngleRange(0.0f, 1.0f, true, false).contains(AngleRange(0.5f, 1.0f, false, false)));
+static_assert(!AngleRange(0.0f, 1.0f, true, false).contains(AngleRange(0.5f, 1.0f, false, true)));
+static_assert(AngleRange(6.0f, 1.0f).contains(AngleRange(-0.1f, 0.1f)));
+
+void test_range_equality() {
+    CHECK(AngleRange::full() != AngleRange(0.0f, 0.0f));
+    CHECK(AngleRange::full() == AngleRange::full(Angle(1.0f)));
+    CHECK(AngleRange::full(Angle(), false, false) != AngleRange::full(Angle(1.0f), false, false));
+    CHECK(AngleRange::full(Angle(1.0f), false, false) == AngleRange::full(Angle(1.0f + 2 * M_PI), false, false));
+    CHECK(AngleRange(-1.0f, 1.0f) == AngleRange(float(2 * M_PI - 1), 1.0f));
+    RangeGenerator next(4);
+    for (int i = 0; i < 20000; ++i) {
+        AngleRange a = next(), b = next();
+        if (a != b) { continue; }
+        CHECK(a.is_full() == b.is_full());
+        CHECK(std::fabs(a.length() - b.length()) < 1e-5);
+    }
+}
+
+// Быстрый разбор чисел должен давать ровно то же, что std::from_chars:
+// то же значение, ту же ошибку и тот же конец разобранного.
+template <typename T>
+void check_parse(const std::string& text) {
+    T fast = 0, slow = 0;
+    const char* last = text.data() + text.size();
+    std::from_chars_result mine = detail::parse_number(text.data(), last, fast);
+    std::from_chars_result reference = std::from_chars(text.data(), last, slow);
+    CHECK(mine.ec == reference.ec && mine.ptr == reference.ptr);
+    if (mine.ec == std::errc() && reference.ec == std::errc()) { CHECK(std::memcmp(&fast, &slow, sizeof(T)) == 0); }
+}
+
+void test_parse_number() {
+    for (const char* text : {"", "-", ".", "-.", "1.", ".5", "-0", "0", "00012.50", "1e5", "1.5E-3", "2.5.1", "1..2",
+            "12345678901234567890123", "0.000000000000000000000001", "16777217", "9007199254740993", "inf", "-nan",
+            "1,5", "+1", "3.14159265358979323846", "-20.00000", "1e", "7 deg"}) {
+        check_parse<float>(text);
+        check_parse<double>(text);
+    }
+    std::mt19937 gen(7);
+    char buffer[64];
+    for (int i = 0; i < 200000; ++i) {
+        uint32_t bits = gen();
+        float value;
+        std::memcpy(&value, &bits, sizeof value);
+        if (i % 2) { value = std::uniform_real_distribution<float>(-20, 20)(gen); }
+        if (i % 4 == 1) { value = Angle::normalize(value); }
+        check_parse<float>(std::string(buffer, std::to_chars(buffer, buffer + sizeof buffer, value).ptr));
+        std::snprintf(buffer, sizeof buffer, "%.7g", value);
+        check_parse<float>(buffer);
+        check_parse<double>(buffer);
+        std::snprintf(buffer, sizeof buffer, "%.*f", int(gen() % 12), value);
+        check_parse<float>(buffer);
+    }
+}
+
+// Индекс против перебора: для каждого угла - ровно те дуги, чей contains
+// его принимает, и поштучно, и пакетом. Углы - концы дуг с соседями и
+// случайные, в том числе вне [0, 2pi).
+void test_range_index() {
+    RangeGenerator next(8);
+    for (int round = 0; round < 300; ++round) {
+        std::vector<AngleRange> ranges;
+        std::size_t size = round % 10 == 0 ? round % 3 : next.gen() % 200;
+        for (std::size_t i = 0; i < size; ++i) { ranges.push_back(next()); }
+        AngleRangeIndex index(ranges);
+        CHECK(index.size() == ranges.size());
+        std::vector<float> rad = probes({}, next.gen);
+        for (std::size_t i = 0; i < std::min<std::size_t>(size, 40); ++i) {
+            for (float x : probes({ranges[i]}, next.gen)) { rad.push_back(x); }
+        }
+        for (int i = 0; i < 64; ++i) { rad.push_back(next.uniform(-7, 14)); }
+        std::vector<std::size_t> offsets, ids;
+        index.query(rad, offsets, ids);
+        CHECK(offsets.size() == rad.size() + 1);
+        for (std::size_t k = 0; k < rad.size(); ++k) {
+            std::vector<std::size_t> expected, found;
+            for (std::size_t i = 0; i < ranges.size(); ++i) {
+                if (ranges[i].contains(Angle(rad[k]))) { expected.push_back(i); }
+            }
+            CHECK(index.query(Angle(rad[k]), found) == expected.size());
+            std::sort(found.begin(), found.end());
+            CHECK(found == expected);
+            CHECK(index.count(Angle(rad[k])) == expected.size());
+            std::vector<std::size_t> batch(ids.begin() + offsets[k], ids.begin() + offsets[k + 1]);
+            std::sort(batch.begin(), batch.end());
+            CHECK(batch == expected);
+        }
+    }
+}
+
+// Классификатор против перебора: номер единственного сектора, чей contains
+// принимает угол, или none. Секторы - куски окружности между случайными
+// разрезами, иногда сгущёнными в узкое окно, чтобы в одну ячейку попадало
+// много границ; соседние секторы касаются концами, но не пересекаются.
+void test_sector_classifier() {
+    RangeGenerator next(9);
+    for (int round = 0; round < 300; ++round) {
+        std::vector<AngleRange> sectors;
+        std::size_t cuts = next.gen() % 300;
+        if (round % 10 == 0) {
+            sectors.push_back(AngleRange::full(Angle(next.uniform(-7, 14)), false, false));
+        }
+        else if (cuts) {
+            std::vector<float> cut;
+            float window = round % 3 == 0 ? 1e-3f : two_pi;
+            float base = next.uniform(0, two_pi - window);
+            for (std::size_t i = 0; i < cuts; ++i) { cut.push_back(base + next.uniform(0, window)); }
+            if (round % 4 == 0) { cut.push_back(0); }
+            std::sort(cut.begin(), cut.end());
+            cut.erase(std::unique(cut.begin(), cut.end()), cut.end());
+            bool taken_end = false;
+            for (std::size_t i = 0; i < cut.size(); ++i) {
+                float end = i + 1 < cut.size() ? cut[i + 1] : cut[0];
+                bool in_start = !taken_end && next.gen() % 2;
+                bool in_end = next.gen() % 2;
+                // Последний сектор кончается там, где начинается первый.
+                if (i + 1 == cut.size() && !sectors.empty() && sectors.front().includesStart()) { in_end = false; }
+                taken_end = false;
+                if (next.gen() % 4 == 0) { continue; }
+                // Начало иногда задаётся вне [0, 2pi), если оттуда приводится точно.
+                float start = cut[i], shifted = cut[i] + float(2 * M_PI);
+                if (next.gen() % 3 == 0 && Angle::normalize(shifted) == start) { start = shifted; }
+                if (cut.size() == 1) {
+                    sectors.push_back(AngleRange::full(Angle(start), in_start, false));
+                    break;
+                }
+                sectors.push_back(AngleRange(start, end, in_start, in_end));
+                taken_end = in_end;
+            }
+        }
+        SectorClassifier classifier(sectors);
+        CHECK(classifier.size() == sectors.size());
+        std::vector<float> rad = probes({}, next.gen);
+        for (std::size_t i = 0; i < std::min<std::size_t>(sectors.size(), 60); ++i) {
+            for (float x : probes({sectors[i]}, next.gen)) { rad.push_back(x); }
+        }
+        for (int i = 0; i < 64; ++i) { rad.push_back(next.uniform(-7, 14)); }
+        std::vector<uint32_t> batch(rad.size());
+        classifier.classify(rad, batch);
+        for (std::size_t k = 0; k < rad.size(); ++k) {
+            uint32_t expected = SectorClassifier::none;
+            std::size_t holders = 0;
+            for (std::size_t i = 0; i < sectors.size(); ++i) {
+                if (sectors[i].contains(Angle(rad[k]))) {
+                    expected = static_cast<uint32_t>(i);
+                    ++holders;
+                }
+            }
+            CHECK(holders <= 1);
+            CHECK(classifier.classify(Angle(rad[k])) == expected);
+            CHECK(batch[k] == expected);
+        }
+    }
+    bool thrown = false;
+    std::vector<AngleRange> overlapping = {AngleRange(0.0f, 1.0f), AngleRange(1.0f, 2.0f)};
+    try { SectorClassifier classifier(overlapping); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    CHECK(thrown);
+}
+
+// Объединение против перебора: угол в объединении, если его принимает
+// хоть одна дуга. Большие наборы узких дуг делятся между потоками, и
+// результат должен совпасть с однопоточным.
+void test_range_set_union() {
+    RangeGenerator next(10);
+    for (int round = 0; round < 60; ++round) {
+        std::vector<AngleRange> ranges;
+        bool large = round % 6 == 0;
+        std::size_t size = large ? 3 * AngleRangeSet::min_chunk + next.gen() % 1000 : next.gen() % 50;
+        for (std::size_t i = 0; i < size; ++i) {
+            if (!large || i % 500 == 0) { ranges.push_back(next()); }
+            else {
+                float start = next.uniform(-7, 14);
+                ranges.push_back(AngleRange(start, start + next.uniform(0, 1e-3f), next.gen() % 2, next.gen() % 2));
+            }
+        }
+        AngleRangeSet serial = AngleRangeSet::union_all(ranges), threaded = AngleRangeSet::union_all(ranges, 4);
+        CHECK(serial == threaded);
+        std::vector<AngleRange> parts = serial.ranges();
+        std::vector<float> rad = probes({}, next.gen);
+        for (std::size_t i = 0; i < std::min<std::size_t>(size, 10); ++i) {
+            for (float x : probes({ranges[next.gen() % size]}, next.gen)) { rad.push_back(x); }
+        }
+        for (const AngleRange& part : parts) {
+            if (rad.size() > 400) { break; }
+            for (float x : probes({part}, next.gen)) { rad.push_back(x); }
+        }
+        for (float x : rad) {
+            bool expected = false;
+            for (const AngleRange& range : ranges) { expected |= range.contains(Angle(x)); }
+            CHECK(serial.contains(Angle(x)) == expected);
+            CHECK(threaded.contains(Angle(x)) == expected);
+            CHECK(pieces_contain(parts, x) == expected);
+        }
+    }
+}
+
+// Профиль покрытия против подсчёта contains. Среди углов - первый угол
+// каждого куска профиля, поэтому максимум подсчёта по ним и есть настоящая
+// наибольшая глубина.
+void test_coverage_profile() {
+    RangeGenerator next(11);
+    for (int round = 0; round < 300; ++round) {
+        std::vector<AngleRange> ranges;
+        std::size_t size = round % 10 == 0 ? round % 2 : next.gen() % 60;
+        for (std::size_t i = 0; i < size; ++i) { ranges.push_back(next()); }
+        CoverageProfile profile(ranges);
+        std::vector<float> rad = probes({}, next.gen);
+        for (const AngleRange& range : ranges) {
+            for (float x : probes({range}, next.gen)) { rad.push_back(x); }
+        }
+        for (const CoverageProfile::Piece& piece : profile.pieces()) {
+            float x;
+            if (detail::first_angle(piece.part, x)) { rad.push_back(x); }
+        }
+        std::vector<uint32_t> expected(rad.size(), 0);
+        uint32_t deepest = 0;
+        for (std::size_t k = 0; k < rad.size(); ++k) {
+            for (const AngleRange& range : ranges) { expected[k] += range.contains(Angle(rad[k])); }
+            deepest = std::max(deepest, expected[k]);
+        }
+        CHECK(profile.max_depth() == deepest);
+        std::vector<AngleRange> max_ranges = profile.max_ranges();
+        CHECK(max_ranges.empty() == (deepest == 0));
+        std::vector<std::vector<AngleRange>> covered;
+        for (uint32_t depth = 0; depth <= deepest + 1; ++depth) { covered.push_back(profile.covered(depth)); }
+        for (std::size_t k = 0; k < rad.size(); ++k) {
+            CHECK(profile.depth(Angle(rad[k])) == expected[k]);
+            CHECK(pieces_contain(max_ranges, rad[k]) == (deepest > 0 && expected[k] == deepest));
+            for (uint32_t depth = 1; depth <= deepest + 1; ++depth) {
+                CHECK(pieces_contain(covered[depth], rad[k]) == (expected[k] >= depth));
+            }
+        }
+        CHECK(std::fabs(profile.length(1) - AngleRangeSet::union_all(ranges).length()) < 1e-4);
+        CHECK(std::fabs(profile.length(0) - 2 * Angle::pi) < 1e-4);
+    }
+}
+
+// BinaryAngle подставляется вместо Angle: смешанные сравнения и арифметика
+// компилируются однозначно, градусы лежат в [0, 360), str() и repr() - те
+// же, что давал std::to_string.
+void test_binary_angle() {
+    Angle a(1.0f);
+    BinaryAngle b(a), c(Angle(2.5f));
+    CHECK(a == b && b == a && !(a != b) && !(b != a));
+    CHECK(a != c && c != a);
+    CHECK((a + c) == Angle(3.5f) && (c - a) == Angle(1.5f) && (c + a) == Angle(3.5f) && (a - c) == Angle(-1.5f));
+    CHECK((a + b) == Angle(2.0f) && (a - b) == Angle(0.0f));
+    CHECK(a < c && !(a > c));
+    CHECK(BinaryAngle(a) + c == BinaryAngle(3.5f));
+    Angle back = c;
+    CHECK(back == Angle(2.5f));
+    CHECK(BinaryAngle::from_degrees(359.9999).getDegrees() == 0);
+    CHECK(BinaryAngle::from_bam(0xffffffff).str() == "0 deg");
+    CHECK(BinaryAngle::from_degrees(-90).str() == "270 deg");
+    std::mt19937 gen(12);
+    for (int i = 0; i < 10000; ++i) {
+        BinaryAngle x = BinaryAngle::from_bam(gen());
+        int deg = x.getDegrees();
+        CHECK(deg >= 0 && deg < 360);
+        CHECK(x.str() == std::to_string(deg) + " deg");
+        CHECK(x.repr() == "BinaryAngle(" + std::to_string(x.getRadians()) + " rad)");
+    }
+}
+
+// Ошибка в ULP типа T относительно значения в long double.
+template <typename T>
+double ulp_error(T value, long double exact) {
+    T rounded = static_cast<T>(exact);
+    T ulp = std::nextafter(std::fabs(rounded), std::numeric_limits<T>::infinity()) - std::fabs(rounded);
+    return double(std::fabs(value - exact) / ulp);
+}
+
+// Уровни точности тригонометрии против std::sin, std::cos и std::tan в long
+// double на углах до trig_limit: exact совпадает с libm, fast укладывается в
+// 2 ULP для sin/cos и 4 ULP для tan вдали от полюсов, table - в 1.3e-6 по
+// модулю; пакетные функции держат те же границы.
+template <typename T>
+void check_trig(unsigned seed) {
+    std::mt19937 gen(seed);
+    std::vector<T> rad = {0, T(-0.0), T(1e-30), T(M_PI / 4), T(M_PI / 2), T(M_PI), T(2 * M_PI), T(-M_PI / 3)};
+    for (int i = 0; i < 20000; ++i) {
+        T scale = i % 2 ? T(2 * M_PI) : std::ldexp(T(1), int(gen() % 20));
+        rad.push_back(std::uniform_real_distribution<T>(-scale, scale)(gen));
+    }
+    for (TrigAccuracy accuracy : {TrigAccuracy::exact, TrigAccuracy::fast, TrigAccuracy::table}) {
+        std::vector<T> sin(rad.size()), cos(rad.size()), tan(rad.size());
+        BasicAngle<T>::sincos(rad, sin, cos, accuracy);
+        BasicAngle<T>::tan(rad, tan, accuracy);
+        double max_sin = 0, max_cos = 0, max_tan = 0;
+        for (std::size_t i = 0; i < rad.size(); ++i) {
+            BasicAngle<T> angle(rad[i]);
+            long double x = rad[i], exact_sin = std::sin(x), exact_cos = std::cos(x);
+            SinCos<T> v = angle.sincos(accuracy);
+            CHECK(angle.sin(accuracy) == v.sin && angle.cos(accuracy) == v.cos);
+            if (accuracy == TrigAccuracy::exact) {
+                CHECK(v.sin == std::sin(rad[i]) && v.cos == std::cos(rad[i]) && angle.tan() == std::tan(rad[i]));
+                CHECK(sin[i] == v.sin && cos[i] == v.cos && tan[i] == angle.tan());
+                continue;
+            }
+            for (T s : {v.sin, sin[i]}) {
+                max_sin = std::max(max_sin, accuracy == TrigAccuracy::fast ? ulp_error(s, exact_sin)
+                    : double(std::fabs(s - exact_sin)));
+            }
+            for (T c : {v.cos, cos[i]}) {
+                max_cos = std::max(max_cos, accuracy == TrigAccuracy::fast ? ulp_error(c, exact_cos)
+                    : double(std::fabs(c - exact_cos)));
+            }
+            if (accuracy == TrigAccuracy::fast && std::fabs(exact_cos) > 1e-3L) {
+                for (T t : {angle.tan(accuracy), tan[i]}) { max_tan = std::max(max_tan, ulp_error(t, std::tan(x))); }
+            }
+        }
+        if (accuracy == TrigAccuracy::fast) { CHECK(max_sin <= 2 && max_cos <= 2 && max_tan <= 4); }
+        if (accuracy == TrigAccuracy::table) { CHECK(max_sin <= 1.3e-6 && max_cos <= 1.3e-6); }
+    }
+}
+
+void test_trig() {
+    check_trig<float>(16);
+    check_trig<double>(17);
+}
+
+// CircularStats::compute побитово не зависит от числа потоков (1, 2, 8 и 0 -
+// по числу ядер) и близок к сумме в long double; с весами - так же.
+void test_circular_stats() {
+    std::mt19937 gen(19);
+    std::vector<float> rad(5 * CircularStats::chunk_size + 123), weights(rad.size());
+    for (std::size_t i = 0; i < rad.size(); ++i) {
+        rad[i] = std::uniform_real_distribution<float>(-1, 2)(gen);
+        weights[i] = std::uniform_real_distribution<float>(0, 3)(gen);
+    }
+    auto same = [](const CircularStats& a, const CircularStats& b) {
+        return a.sin_sum() == b.sin_sum() && a.cos_sum() == b.cos_sum() && a.weight() == b.weight();
+    };
+    for (TrigAccuracy accuracy : {TrigAccuracy::exact, TrigAccuracy::fast, TrigAccuracy::table}) {
+        CircularStats plain = CircularStats::compute(rad, accuracy, 1);
+        CircularStats weighted = CircularStats::compute(rad, weights, accuracy, 1);
+        for (unsigned threads : {2u, 8u, 0u}) {
+            CHECK(same(CircularStats::compute(rad, accuracy, threads), plain));
+            CHECK(same(CircularStats::compute(rad, weights, accuracy, threads), weighted));
+        }
+        long double sin = 0, cos = 0, weighted_sin = 0, weighted_cos = 0, weight = 0;
+        for (std::size_t i = 0; i < rad.size(); ++i) {
+            sin += std::sin((long double)rad[i]);
+            cos += std::cos((long double)rad[i]);
+            weighted_sin += weights[i] * std::sin((long double)rad[i]);
+            weighted_cos += weights[i] * std::cos((long double)rad[i]);
+            weight += weights[i];
+        }
+        double tolerance = rad.size() * (accuracy == TrigAccuracy::table ? 2e-6 : 2e-7);
+        CHECK(std::fabs(plain.sin_sum() - sin) <= tolerance && std::fabs(plain.cos_sum() - cos) <= tolerance);
+        CHECK(plain.weight() == rad.size());
+        CHECK(std::fabs(weighted.sin_sum() - weighted_sin) <= 3 * tolerance);
+        CHECK(std::fabs(weighted.cos_sum() - weighted_cos) <= 3 * tolerance);
+        CHECK(std::fabs(weighted.weight() - weight) <= 1e-6 * weight);
+    }
+}
+
+// CircularWindow после многих push, пачек и pop, в том числе через несколько
+// пересчётов resum, совпадает с суммами, посчитанными по окну заново.
+void test_circular_window() {
+    std::mt19937 gen(20);
+    for (TrigAccuracy accuracy : {TrigAccuracy::exact, TrigAccuracy::fast}) {
+        CircularWindow window(37, accuracy);
+        std::deque<float> expected;
+        for (int step = 0; step < 20000; ++step) {
+            if (gen() % 10 == 0 && !expected.empty()) {
+                window.pop();
+                expected.pop_front();
+            }
+            else if (gen() % 4 == 0) {
+                std::vector<float> batch(gen() % 100);
+                for (float& rad : batch) { rad = std::uniform_real_distribution<float>(-10, 10)(gen); }
+                window.push(batch);
+                expected.insert(expected.end(), batch.begin(), batch.end());
+            }
+            else {
+                float rad = std::uniform_real_distribution<float>(-10, 10)(gen);
+                window.push(Angle(rad));
+                expected.push_back(rad);
+            }
+            while (expected.size() > window.capacity()) { expected.pop_front(); }
+            CHECK(window.size() == expected.size());
+            if (step % 97 != 0) { continue; }
+            long double sin = 0, cos = 0;
+            for (float rad : expected) {
+                SinCos<float> v = Angle(rad).sincos(accuracy);
+                sin += v.sin;
+                cos += v.cos;
+            }
+            CircularStats stats = window.stats();
+            CHECK(std::fabs(stats.sin_sum() - sin) <= 1e-12 && std::fabs(stats.cos_sum() - cos) <= 1e-12);
+            CHECK(stats.weight() == expected.size());
+        }
+    }
+    CircularWindow window(4);
+    window.push(Angle(1));
+    window.clear();
+    CHECK(window.empty() && window.stats().sin_sum() == 0);
+    bool thrown = false;
+    try { window.pop(); }
+    catch (const std::out_of_range&) { thrown = true; }
+    CHECK(thrown);
+}
+
+// Пакетные contains и contains_indices совпадают с поштучным contains,
+// в том числе на углах вне [0, 2pi) и на нескольких блоках normalize.
+void test_range_contains_batch() {
+    RangeGenerator next(6);
+    for (int i = 0; i < 2000; ++i) {
+        AngleRange range = next();
+        std::vector<float> rad;
+        while (rad.size() < 2 * detail::normalize_block_size + 5) {
+            for (float x : probes({range}, next.gen)) {
+                rad.push_back(x);
+                rad.push_back(x + float(int(next.gen() % 7) - 3) * float(2 * M_PI));
+            }
+        }
+        rad.resize(next.gen() % rad.size());
+        std::vector<uint8_t> mask(rad.size());
+        std::vector<std::size_t> indices(rad.size());
+        range.contains(rad, mask);
+        std::size_t count = range.contains_indices(rad, indices), expected = 0;
+        for (std::size_t j = 0; j < rad.size(); ++j) {
+            bool inside = range.contains(Angle(rad[j]));
+            CHECK(mask[j] == inside);
+            if (inside) { CHECK(expected < count && indices[expected++] == j); }
+        }
+        CHECK(count == expected);
+    }
+}
+
+// Операции AngleRangeSet против принадлежности по определению: точка входит
+// в объединение, пересечение, разность и дополнение, если этого требуют её
+// вхождения в исходные дуги. Точки - probes исходных дуг и кусков результата.
+void test_range_set_ops() {
+    RangeGenerator next(7);
+    for (int round = 0; round < 3000; ++round) {
+        std::vector<AngleRange> first, second;
+        AngleRangeSet a, b;
+        for (std::size_t i = next.gen() % 4; i > 0; --i) { a.unite(first.emplace_back(next())); }
+        for (std::size_t i = next.gen() % 4; i > 0; --i) { b.unite(second.emplace_back(next())); }
+        auto in = [](const std::vector<AngleRange>& ranges, float x) {
+            bool result = false;
+            for (const AngleRange& range : ranges) { result |= brute_contains(range, x); }
+            return result;
+        };
+        AngleRangeSet united = a, common = a, difference = a, complement = a;
+        united.unite(b);
+        common.intersect(b);
+        difference.subtract(b);
+        complement.complement();
+        CHECK((AngleRangeSet(a) += b) == united && (AngleRangeSet(a) &= b) == common);
+        CHECK((AngleRangeSet(a) -= b) == difference);
+        // С одной дугой - то же, что с множеством из неё.
+        AngleRange range = next();
+        AngleRangeSet single(range);
+        CHECK((AngleRangeSet(a) += range) == (AngleRangeSet(a) += single));
+        CHECK((AngleRangeSet(a) &= range) == (AngleRangeSet(a) &= single));
+        CHECK((AngleRangeSet(a) -= range) == (AngleRangeSet(a) -= single));
+        std::vector<float> rad = probes({range}, next.gen);
+        for (const auto* ranges : {&first, &second}) {
+            for (const AngleRange& r : *ranges) {
+                for (float x : probes({r}, next.gen)) { rad.push_back(x); }
+            }
+        }
+        for (const AngleRangeSet* set : {&united, &common, &difference, &complement}) {
+            for (const AngleRange& part : set->ranges()) {
+                for (float x : probes({part}, next.gen)) { rad.push_back(x); }
+            }
+        }
+        for (float x : rad) {
+            bool in_a = in(first, x), in_b = in(second, x);
+            CHECK(a.contains(Angle(x)) == in_a);
+            CHECK(united.contains(Angle(x)) == (in_a || in_b));
+            CHECK(common.contains(Angle(x)) == (in_a && in_b));
+            CHECK(difference.contains(Angle(x)) == (in_a && !in_b));
+            CHECK(complement.contains(Angle(x)) == !in_a);
+            CHECK(pieces_contain(united.ranges(), x) == (in_a || in_b));
+            CHECK(pieces_contain(complement.ranges(), x) == !in_a);
+        }
+        CHECK(AngleRangeSet(complement).complement() == a);
+    }
+}
+
+// Каждая операция AngleBuffer даёт для каждого элемента то же, что и
+// соответствующая операция Angle; сравнения - с углами, в том числе равными
+// элементам и отличающимися от них на оборот.
+void test_angle_buffer() {
+    std::mt19937 gen(5);
+    std::vector<float> rad = {0, -0.0f, two_pi, float(2 * M_PI), float(-M_PI), 1e-9f, -1e-9f, 1e5f};
+    while (rad.size() < 2 * detail::normalize_block_size + 7) {
+        float scale = std::ldexp(1.0f, int(gen() % 16) - 4);
+        rad.push_back(std::uniform_real_distribution<float>(-scale, scale)(gen));
+    }
+    std::vector<float> other(rad.size());
+    for (float& x : other) { x = std::uniform_real_distribution<float>(-7, 14)(gen); }
+    std::vector<Angle> angles(rad.begin(), rad.end());
+    CHECK(std::ranges::equal(AngleBuffer(std::span<const Angle>(angles)).radians(), rad));
+    AngleBuffer degrees = AngleBuffer::from_degrees(rad);
+    for (std::size_t i = 0; i < rad.size(); ++i) {
+        CHECK(degrees[i].getRadians() == Angle::from_degrees(rad[i]).getRadians());
+    }
+
+    const Angle shift(2.5f);
+    AngleBuffer sum = AngleBuffer::from_radians(rad), pairwise = sum, scaled = sum, normalized = sum;
+    sum.add(shift);
+    pairwise.add(AngleBuffer::from_radians(other));
+    scaled.scale(-1.75f);
+    normalized.normalize();
+    std::vector<int> deg(rad.size());
+    AngleBuffer::from_radians(rad).to_degrees(deg);
+    for (std::size_t i = 0; i < rad.size(); ++i) {
+        Angle angle(rad[i]);
+        CHECK(sum[i].getRadians() == (angle + shift).getRadians());
+        CHECK(pairwise[i].getRadians() == (angle + Angle(other[i])).getRadians());
+        CHECK(scaled[i].getRadians() == (angle * -1.75f).getRadians());
+        CHECK(normalized[i].getRadians() == Angle::normalize(rad[i]));
+        CHECK(deg[i] == angle.getDegrees());
+    }
+
+    AngleBuffer buffer = AngleBuffer::from_radians(rad);
+    std::vector<uint8_t> less(rad.size()), less_equal(rad.size()), greater(rad.size()), greater_equal(rad.size());
+    std::vector<uint8_t> equal(rad.size());
+    for (int round = 0; round < 200; ++round) {
+        float x = round % 3 ? rad[gen() % rad.size()] : std::uniform_real_distribution<float>(-7, 14)(gen);
+        Angle pivot(round % 2 ? x + float(2 * M_PI) : x);
+        buffer.less(pivot, less);
+        buffer.less_equal(pivot, less_equal);
+        buffer.greater(pivot, greater);
+        buffer.greater_equal(pivot, greater_equal);
+        buffer.equal(pivot, equal);
+        for (std::size_t i = 0; i < rad.size(); ++i) {
+            Angle angle(rad[i]);
+            CHECK(less[i] == (angle < pivot) && less_equal[i] == (angle <= pivot));
+            CHECK(greater[i] == (angle > pivot) && greater_equal[i] == (angle >= pivot));
+            CHECK(equal[i] == (angle == pivot));
+        }
+    }
+}
+
+// PackedAngleRange ведёт себя как AngleRange, из которой получена: те же
+// принадлежность, длина, концы и флаги, пакетная маска совпадает с
+// поштучной, а обратное преобразование даёт равную дугу.
+void test_packed_range() {
+    RangeGenerator next(15);
+    for (int round = 0; round < 500; ++round) {
+        std::vector<AngleRange> ranges;
+        std::vector<PackedAngleRange> packed;
+        for (std::size_t i = next.gen() % 40; i > 0; --i) {
+            ranges.push_back(next());
+            packed.push_back(ranges.back());
+        }
+        for (std::size_t i = 0; i < ranges.size(); ++i) {
+            const AngleRange& range = ranges[i];
+            CHECK(packed[i].includesStart() == range.includesStart() && packed[i].includesEnd() == range.includesEnd());
+            CHECK(packed[i].is_full() == range.is_full());
+            CHECK(packed[i].getStart().getRadians() == Angle::normalize(range.getStart().getRadians()));
+            CHECK(packed[i].length() == range.length());
+            CHECK(AngleRange(packed[i]) == range && PackedAngleRange(AngleRange(packed[i])) == packed[i]);
+            for (float x : probes({range}, next.gen)) {
+                CHECK(packed[i].contains(Angle(x)) == range.contains(Angle(x)));
+                CHECK(packed[i].contains(NormalizedAngle(Angle(x))) == range.contains(Angle(x)));
+            }
+        }
+        std::vector<uint8_t> mask(packed.size());
+        for (float x : probes({ranges.empty() ? AngleRange::full() : ranges[0]}, next.gen)) {
+            PackedAngleRange::contains(packed, Angle(x), mask);
+            for (std::size_t i = 0; i < ranges.size(); ++i) { CHECK(mask[i] == ranges[i].contains(Angle(x))); }
+        }
+    }
+}
+
+// Angle::parse и AngleRange::parse читают то, что пишут str() и repr(), и
+// разобранное значение печатается в ту же строку: repr хранит радианы с
+// шестью знаками после точки, str - целые градусы. На ошибке ptr == first и
+// значение не меняется.
+void test_parse() {
+    RangeGenerator next(11);
+    for (int i = 0; i < 20000; ++i) {
+        float scale = std::ldexp(1.0f, int(next.gen() % 60) - 30);
+        Angle angle(next.uniform(-scale, scale)), parsed;
+        std::string repr = angle.repr(), str = angle.str();
+        std::from_chars_result result = Angle::parse(repr, parsed);
+        CHECK(result.ec == std::errc() && result.ptr == repr.data() + repr.size());
+        CHECK(parsed.repr() == repr && std::fabs(parsed.getRadians() - angle.getRadians()) <= 5e-7 * (1 + scale));
+        // Дальше 2^24 градусов целые градусы во float уже не точны.
+        if (scale <= 1 << 18) {
+            result = Angle::parse(str, parsed);
+            CHECK(result.ec == std::errc() && result.ptr == str.data() + str.size() && parsed.str() == str);
+        }
+
+        AngleRange range = next(), parsed_range = AngleRange::full();
+        repr = range.repr();
+        str = range.str();
+        result = AngleRange::parse(repr, parsed_range);
+        CHECK(result.ec == std::errc() && result.ptr == repr.data() + repr.size() && parsed_range.repr() == repr);
+        result = AngleRange::parse(str, parsed_range);
+        CHECK(result.ec == std::errc() && result.ptr == str.data() + str.size() && parsed_range.str() == str);
+    }
+    Angle angle;
+    CHECK(Angle::parse("30deg", angle).ec == std::errc() && angle.getRadians() == Angle::from_degrees(30).getRadians());
+    CHECK(Angle::parse("1.5 rad", angle).ec == std::errc() && angle.getRadians() == 1.5f);
+    for (std::string_view text : {"", "45", "45 grad", "deg", "Angle(1 rad", "Angle(1 deg]"}) {
+        Angle value(2);
+        std::from_chars_result result = Angle::parse(text, value);
+        CHECK(result.ec == std::errc::invalid_argument && result.ptr == text.data() && value.getRadians() == 2);
+    }
+    const AngleRange original(1, 2, true, false);
+    for (std::string_view text : {"", "[1 deg; 2 deg", "(1 deg, 2 deg)", "[1 deg 2 deg]",
+        "AngleRange(Angle(1 rad), Angle(2 rad), true)"}) {
+        AngleRange value = original;
+        std::from_chars_result result = AngleRange::parse(text, value);
+        CHECK(result.ec == std::errc::invalid_argument && result.ptr == text.data() && value.repr() == original.repr());
+    }
+}
+
+// Вызов f бросает исключение типа E.
+template <typename E, typename F>
+bool throws(F f) {
+    try { f(); }
+    catch (const E&) { return true; }
+    catch (...) { return false; }
+    return false;
+}
+
+// AngleFile читает записанное побитово: углы из радиан и из Angle, дуги со
+// столбцами и флагами. Обрезанный файл, чужой заголовок, другой тип значения,
+// обращение к столбцам другого содержимого и отсутствующий файл - ошибки.
+void test_angle_file() {
+    namespace fs = std::filesystem;
+    const std::string path = (fs::temp_directory_path() / "angle_tests.bin").string();
+    RangeGenerator next(13);
+    std::vector<float> rad = {0, -0.0f, two_pi, -1e30f, std::numeric_limits<float>::infinity()};
+    std::vector<AngleRange> ranges;
+    for (int i = 0; i < 1000; ++i) {
+        rad.push_back(next.uniform(-100, 100));
+        ranges.push_back(next());
+    }
+    std::vector<Angle> angles(rad.begin(), rad.end());
+    for (bool from_angles : {false, true}) {
+        if (from_angles) { AngleFile::write(path, std::span<const Angle>(angles)); }
+        else { AngleFile::write(path, std::span<const float>(rad)); }
+        AngleFile file(path);
+        CHECK(!file.holds_ranges() && file.size() == rad.size());
+        CHECK(std::memcmp(file.radians().data(), rad.data(), rad.size() * sizeof(float)) == 0);
+        CHECK(std::bit_cast<uint32_t>(file.angle(1).getRadians()) == std::bit_cast<uint32_t>(-0.0f));
+        CHECK(throws<std::invalid_argument>([&] { file.starts(); }));
+        CHECK(throws<std::invalid_argument>([&] { file.range(0); }));
+        CHECK(throws<std::invalid_argument>([&] { BasicAngleFile<double> wrong(path); }));
+    }
+    AngleFile::write(path, std::span<const AngleRange>(ranges));
+    {
+        AngleFile file(path);
+        CHECK(file.holds_ranges() && file.size() == ranges.size());
+        for (std::size_t i = 0; i < ranges.size(); ++i) {
+            CHECK(file.starts()[i] == ranges[i].getStart().getRadians() && file.ends()[i] == ranges[i].getEnd().getRadians());
+            CHECK(file.range(i).repr() == ranges[i].repr() && file.range(i).is_full() == ranges[i].is_full());
+        }
+        CHECK(throws<std::invalid_argument>([&] { file.radians(); }));
+        CHECK(throws<std::invalid_argument>([&] { file.angle(0); }));
+    }
+    // Без последнего байта флагов последней дуги не хватает.
+    fs::resize_file(path, fs::file_size(path) - 1);
+    CHECK(throws<std::invalid_argument>([&] { AngleFile file(path); }));
+    AngleFile::write(path, std::span<const float>());
+    CHECK(AngleFile(path).size() == 0);
+    fs::resize_file(path, AngleFile::header_size - 1);
+    CHECK(throws<std::invalid_argument>([&] { AngleFile file(path); }));
+    fs::resize_file(path, 0);
+    CHECK(throws<std::invalid_argument>([&] { AngleFile file(path); }));
+    std::ofstream(path, std::ios::binary) << std::string(AngleFile::header_size, 'x');
+    CHECK(throws<std::invalid_argument>([&] { AngleFile file(path); }));
+    fs::remove(path);
+    CHECK(throws<std::runtime_error>([&] { AngleFile file(path); }));
+    CHECK(throws<std::runtime_error>([&] { AngleFile::write("/nonexistent/angle_tests.bin", std::span<const float>(rad)); }));
+}
+
+int main() {
+    test_normalize();
+    test_from_vector();
+    test_rotation();
+    test_range_contains();
+    test_range_length();
+    test_range_operators();
+    test_range_equality();
+    test_parse_number();
+    test_range_index();
+    test_sector_classifier();
+    test_range_set_union();
+    test_coverage_profile();
+    test_binary_angle();
+    test_trig();
+    test_circular_stats();
+    test_circular_window();
+    test_range_contains_batch();
+    test_range_set_ops();
+    test_angle_buffer();
+    test_packed_range();
+    test_parse();
+    test_angle_file();
+    if (failures) { std::fprintf(stderr, "%d checks failed\n", failures); }
+    return failures ? 1 : 0;
+}